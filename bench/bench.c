@@ -0,0 +1,279 @@
+/**
+ * @file bench.c
+ * @brief Microbenchmark suite for the hot paths of the game logic.
+ *
+ * @details Runs the move, random placement, legal move and evaluation
+ * functions over a fixed corpus of recorded game boards, repeating each
+ * benchmark over several samples, and reports the time per operation, the
+ * operations per second and the variance across the samples, either as a
+ * table or as a JSON document for machine consumption.
+ *
+ * Alternatively reports the scaling of the parallel expectimax search,
+ * by searching the corpus with each number of threads up to the specified
+ * number and comparing the nodes searched per second with a single thread.
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "ai.h"
+#include "logic.h"
+#include "options.h"
+#include "random.h"
+#include "stats.h"
+#include "shared.h"
+#include "consts.h"
+#include "corpus.h"
+
+// Runs a single pass of a benchmark over the corpus, and returns
+// a value derived from the results to keep them from being elided.
+typedef board_t (*bench_t)(void);
+
+typedef struct
+{
+    const char *name;
+    bench_t run;
+} Benchmark;
+
+// Stores the results of an individual benchmark.
+typedef struct
+{
+    double mean;
+    double variance;
+    double min;
+} BenchResult;
+
+static const char *usage = "Usage: %s [--json] [--samples N] [--rounds N] [--scaling N [--depth N]]\n";
+
+// Sink for the benchmark results to prevent them from being optimized out.
+static volatile board_t sink;
+
+// Game struct shared by the benchmarks, whose random number
+// generator is seeded with a fixed value to keep the random
+// placements identical across runs.
+static Game game;
+
+// Defines a benchmark function performing the specified operation on a
+// Game struct comprising each board of the corpus, evaluating to a value
+// derived from the result of the operation.
+#define DEFINE_BENCH(name, op)                    \
+    static board_t bench_##name(void)             \
+    {                                             \
+        board_t acc = 0;                          \
+                                                  \
+        for (len_t i = 0; i < corpus_len; ++i)    \
+        {                                         \
+            game.board = corpus[i];               \
+            acc ^= (board_t)(op);                 \
+        }                                         \
+                                                  \
+        return acc;                               \
+    }
+
+DEFINE_BENCH(move_left, (move_horizontal(&game, true), game.board))
+DEFINE_BENCH(move_right, (move_horizontal(&game, false), game.board))
+DEFINE_BENCH(move_up, (move_vertical(&game, true), game.board))
+DEFINE_BENCH(move_down, (move_vertical(&game, false), game.board))
+// The random placement selects among the number of empty cells maintained
+// in the Game struct, which is counted for each board of the corpus as the
+// boards are not reached through the moves.
+DEFINE_BENCH(place_random,
+             (game.empty = __builtin_popcount(empty_mask(game.board)), place_random(&game),
+              game.board))
+DEFINE_BENCH(next_random, next_random(&game.rng))
+DEFINE_BENCH(legal_moves, legal_moves(game.board))
+DEFINE_BENCH(evaluate, evaluate_board(game.board))
+
+static const Benchmark benchmarks[] = {
+    {"move_left", bench_move_left},
+    {"move_right", bench_move_right},
+    {"move_up", bench_move_up},
+    {"move_down", bench_move_down},
+    {"place_random", bench_place_random},
+    {"next_random", bench_next_random},
+    {"legal_moves", bench_legal_moves},
+    {"evaluate", bench_evaluate},
+};
+
+static const len_t bench_cnt = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+/**
+ * @brief Runs the specified benchmark and computes its statistics.
+ *
+ * @details Each sample times the specified number of passes over the
+ * corpus. A single untimed pass is performed beforehand to warm up the
+ * caches and the branch predictors.
+ *
+ * @param bench Pointer to the Benchmark struct to be run.
+ * @param samples Number of samples to be recorded.
+ * @param rounds Number of passes over the corpus per sample.
+ *
+ * @return BenchResult struct comprising the time per operation in
+ * nanoseconds averaged across the samples, along with its variance
+ * and the minimum across the samples.
+ */
+static BenchResult run_benchmark(const Benchmark *bench, uint32_t samples, uint32_t rounds)
+{
+    BenchResult result = {.min = INFINITY};
+    double ns, sum = 0, sum_sq = 0;
+
+    board_t acc = bench->run();
+
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        uint64_t start = clock_ns();
+
+        for (uint32_t r = 0; r < rounds; ++r)
+            acc ^= bench->run();
+
+        ns = (double)(clock_ns() - start) / ((double)rounds * corpus_len);
+
+        sum += ns, sum_sq += ns * ns;
+
+        if (ns < result.min)
+            result.min = ns;
+    }
+
+    sink = acc;
+
+    result.mean = sum / samples;
+    result.variance = samples > 1 ? (sum_sq - sum * result.mean) / (samples - 1) : 0;
+
+    // Guards against negative values resulting from rounding errors.
+    if (result.variance < 0)
+        result.variance = 0;
+
+    return result;
+}
+
+/**
+ * @brief Reports the scaling of the parallel search with the thread count.
+ *
+ * @details Searches every game board of the corpus with each number of
+ * threads from 1 to the specified number, with a fresh transposition table
+ * for each number of threads, and displays the nodes searched per second
+ * along with the speedup and the efficiency relative to a single thread.
+ *
+ * @param threads Maximum number of threads.
+ * @param depth Depth of the search.
+ *
+ * @return Boolean value indicating whether the report was successful.
+ */
+static bool report_scaling(uint32_t threads, uint32_t depth)
+{
+    double base = 0;
+
+    printf("%-8s %14s %10s %14s %8s %10s\n", "threads", "nodes", "seconds", "nodes/sec",
+           "speedup", "efficiency");
+
+    for (uint32_t cnt = 1; cnt <= threads; ++cnt)
+    {
+        TransTable table;
+        uint64_t nodes = 0;
+
+        if (!init_table(&table, (size_t)TABLE_BUDGET << 20))
+            return false;
+
+        if (!init_search_pool(cnt))
+        {
+            free_table(&table);
+            return false;
+        }
+
+        uint64_t start = clock_ns();
+
+        for (len_t i = 0; i < corpus_len; ++i)
+            nodes += search_move(corpus[i], depth, &table).nodes;
+
+        double elapsed = (clock_ns() - start) / 1e9, rate = nodes / elapsed;
+
+        free_search_pool();
+        free_table(&table);
+
+        if (cnt == 1)
+            base = rate;
+
+        printf("%-8u %14llu %10.3f %14.0f %7.2fx %9.1f%%\n", cnt, (unsigned long long)nodes,
+               elapsed, rate, rate / base, 100 * rate / base / cnt);
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option long_options[] = {
+        {"json", no_argument, NULL, 'j'},
+        {"samples", required_argument, NULL, 's'},
+        {"rounds", required_argument, NULL, 'r'},
+        {"scaling", required_argument, NULL, 't'},
+        {"depth", required_argument, NULL, 'd'},
+        {NULL, 0, NULL, 0},
+    };
+
+    // The scaling is measured deeper than the default depth of the search,
+    // such that the searches of the corpus outweigh starting the threads.
+    uint32_t samples = 10, rounds = 500, threads = 0, depth = 5;
+    bool json = false;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "", long_options, NULL)) != -1)
+    {
+        if (opt == 'j')
+            json = true;
+
+        else if (!(opt == 's' && parse_count(optarg, &samples)) &&
+                 !(opt == 'r' && parse_count(optarg, &rounds)) &&
+                 !(opt == 't' && parse_count(optarg, &threads) && threads <= MAX_THREADS) &&
+                 !(opt == 'd' && parse_count(optarg, &depth) && depth <= MAX_AI_DEPTH))
+        {
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    seed_rng(&game.rng, 0);
+    init_move_tables();
+    init_ai();
+
+    if (threads)
+    {
+        if (report_scaling(threads, depth))
+            return EXIT_SUCCESS;
+
+        fprintf(stderr, "Unable to set up the search with %u threads.\n", threads);
+        return EXIT_FAILURE;
+    }
+
+    if (json)
+        printf("{\n  \"corpus\": %u,\n  \"samples\": %u,\n  \"rounds\": %u,\n  \"benchmarks\": [\n",
+               corpus_len, samples, rounds);
+
+    else
+        printf("%-14s %10s %10s %10s %14s\n", "benchmark", "ns/op", "stddev", "min", "ops/sec");
+
+    for (len_t i = 0; i < bench_cnt; ++i)
+    {
+        BenchResult result = run_benchmark(&benchmarks[i], samples, rounds);
+        double ops = 1e9 / result.mean;
+
+        if (json)
+            printf("    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"variance\": %.6f, "
+                   "\"stddev\": %.3f, \"min\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+                   benchmarks[i].name, result.mean, result.variance, sqrt(result.variance),
+                   result.min, ops, i + 1 < bench_cnt ? "," : "");
+
+        else
+            printf("%-14s %10.2f %10.3f %10.2f %14.0f\n", benchmarks[i].name,
+                   result.mean, sqrt(result.variance), result.min, ops);
+    }
+
+    if (json)
+        printf("  ]\n}\n");
+
+    return EXIT_SUCCESS;
+}
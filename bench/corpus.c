@@ -0,0 +1,189 @@
+/**
+ * @file corpus.c
+ * @brief Defines the fixed corpus of game boards used by the benchmarks.
+ *
+ * @details The boards were recorded from greedy self-play games seeded
+ * with a fixed value, sampling positions from all the stages of a game,
+ * such that the benchmarks exercise a realistic mix of tile layouts. The
+ * corpus must not be regenerated, as the results would no longer be
+ * comparable against the results of the previous runs.
+ */
+
+#include "corpus.h"
+#include "shared.h"
+
+const board_t corpus[] = {
+    0x1213014600030010ULL, 0x1000431075403111ULL, 0x2000240176202320ULL,
+    0x2615341117401310ULL, 0x1421737342102010ULL, 0x2112026418530102ULL,
+    0x2113624048100510ULL, 0x3412268325621201ULL, 0x1412468435612310ULL,
+    0x0121000100000000ULL, 0x0111022300500010ULL, 0x0101000400051022ULL,
+    0x0002100200320462ULL, 0x0100200042002410ULL, 0x1540241000000100ULL,
+    0x0000100001541242ULL, 0x0000001025012352ULL, 0x0010045016203213ULL,
+    0x2540371014001001ULL, 0x0010714052602310ULL, 0x1721524023602000ULL,
+    0x2731152446212100ULL, 0x0103000203830142ULL, 0x0003010203831142ULL,
+    0x2184632115002410ULL, 0x1210642131842631ULL, 0x2421371521820031ULL,
+    0x0152028634422721ULL, 0x0100000120041122ULL, 0x1001000000031364ULL,
+    0x0002010000031364ULL, 0x1162031100030004ULL, 0x2000120173004100ULL,
+    0x2315117500020000ULL, 0x0150216034721353ULL, 0x1352346313715001ULL,
+    0x0153002400610001ULL, 0x0001001201140473ULL, 0x0043107432512532ULL,
+    0x3240610037401521ULL, 0x1301272036406153ULL, 0x1000000000000011ULL,
+    0x0100000000003101ULL, 0x3201000000001000ULL, 0x0001400020001002ULL,
+    0x0000100043013100ULL, 0x0233004100301000ULL, 0x0142004201060002ULL,
+    0x0004103226642312ULL, 0x1001440017412412ULL, 0x1032005303722215ULL,
+    0x1342057304522231ULL, 0x0272153217423423ULL, 0x0010474076321122ULL,
+    0x1002004776420242ULL, 0x0210000000000000ULL, 0x3100221034322211ULL,
+    0x1001321015404140ULL, 0x0010002103520126ULL, 0x2320130056101300ULL,
+    0x3312054107000010ULL, 0x1312247143641543ULL, 0x3200220010000010ULL,
+    0x0013001400030011ULL, 0x0242015400031002ULL, 0x1161000204740033ULL,
+    0x2532162057011000ULL, 0x3132052106570012ULL, 0x0322000200000101ULL,
+    0x4200310000001000ULL, 0x0000000051002101ULL, 0x5321000300120002ULL,
+    0x3413052410220001ULL, 0x3413524123000001ULL, 0x0001034215242341ULL,
+    0x1342005410450001ULL, 0x0002104400552341ULL, 0x0010320065002341ULL,
+    0x0352007301540021ULL, 0x1025007210262412ULL, 0x1001510025004810ULL,
+    0x0353042500811002ULL, 0x0100003010628514ULL, 0x2010841036341521ULL,
+    0x1001000346346281ULL, 0x0031119402512642ULL, 0x4141129325431610ULL,
+    0x1351571323911231ULL, 0x0422035300020011ULL, 0x0010150036002230ULL,
+    0x3010450060003100ULL, 0x2142162354521132ULL, 0x1413075200251000ULL,
+    0x0223004601020000ULL, 0x0331065401010001ULL, 0x0001002307452113ULL,
+    0x2101230074504000ULL, 0x0013007153510122ULL, 0x2172463020002100ULL,
+    0x5132167235300001ULL, 0x0023348401250102ULL, 0x2110124034854231ULL,
+    0x3140143532814131ULL, 0x0000000000123401ULL, 0x3412000100000100ULL,
+    0x2311500030014000ULL, 0x2100511030001500ULL, 0x0000000201061531ULL,
+    0x0272251301510002ULL, 0x1700310064101213ULL, 0x2173123500060001ULL,
+    0x0017001413650213ULL, 0x1715023510610040ULL, 0x2162363027113400ULL,
+    0x1432106000000000ULL, 0x0042015600332131ULL, 0x1000200145002323ULL,
+    0x1521231310040002ULL, 0x3430325113005000ULL, 0x1341026201140000ULL,
+    0x1000310016401343ULL, 0x1200123723542511ULL, 0x0281013210020000ULL,
+    0x1112382004001000ULL, 0x2141102810040002ULL, 0x1200221035348130ULL,
+    0x4101370081412323ULL, 0x2410372182151321ULL, 0x1241837312151024ULL,
+    0x4720430029102000ULL, 0x7132339415310006ULL, 0x2173649405420123ULL,
+    0x2371279342410110ULL, 0x1200591128642253ULL, 0x0012159228640353ULL,
+    0x1513389413635210ULL, 0x0000000030002101ULL, 0x1323454522611000ULL,
+    0x1232417446101010ULL, 0x0100284112213424ULL, 0x0010013382461321ULL,
+    0x0102008502740421ULL, 0x2182027504241002ULL, 0x0470164204231182ULL,
+    0x1271465212841521ULL, 0x0000010000000021ULL, 0x0100000000000121ULL,
+    0x1001100050003100ULL, 0x0002000201350012ULL, 0x0024002500020101ULL,
+    0x0004010500121231ULL, 0x0011003212732351ULL, 0x2312347311512001ULL,
+    0x0114017204610254ULL, 0x0242002300150021ULL, 0x1135035206240241ULL,
+    0x0001041502722351ULL, 0x0011003000732723ULL, 0x0004001504831121ULL,
+    0x0121102305368241ULL, 0x0100450078402311ULL, 0x0100000200031211ULL,
+    0x1101500020010000ULL, 0x0000000200541123ULL, 0x0141026300010001ULL,
+    0x1000240034202611ULL, 0x3311151263105200ULL, 0x1222745110061003ULL,
+    0x0035145601720003ULL, 0x0381123200430012ULL, 0x1381023201430022ULL,
+    0x1300311063203812ULL, 0x6132238502410010ULL, 0x2513342158701241ULL,
+    0x3511535018722410ULL, 0x3521535218702411ULL, 0x1230001000000000ULL,
+    0x0032046502420104ULL, 0x1000300021515711ULL, 0x2000640123502373ULL,
+    0x0361067301331010ULL, 0x3610673014102000ULL, 0x0361067301410102ULL,
+    0x1000102057702511ULL, 0x2101310062502280ULL, 0x1000410063003851ULL,
+    0x1241386201530001ULL, 0x1241486354111200ULL, 0x2242486415431100ULL,
+    0x0032001100000000ULL, 0x2262343002100100ULL, 0x1341006200150002ULL,
+    0x1341620015002010ULL, 0x3468453100130101ULL, 0x3468453100231002ULL,
+    0x0000001010001200ULL, 0x0002000511210542ULL, 0x0012001501310542ULL,
+    0x0000560045211210ULL, 0x5621451012000010ULL, 0x3271152336112300ULL,
+    0x0000000200011113ULL, 0x0100000044001101ULL, 0x1001600040401410ULL,
+    0x2110641050001000ULL, 0x0042564100411000ULL, 0x1310350045432621ULL,
+    0x2111345457103010ULL, 0x3123354114721530ULL, 0x0311164025732321ULL,
+    0x3100125762602310ULL, 0x0000020118205252ULL, 0x0002001201815353ULL,
+    0x5211038300510013ULL, 0x5220383051001310ULL, 0x0000000010002102ULL,
+    0x0252001510020001ULL, 0x1252250021001000ULL, 0x1252350011000010ULL,
+    0x1232432614002010ULL, 0x0000110107421233ULL, 0x1004023172452132ULL,
+    0x2563017101130001ULL, 0x0000051127235163ULL, 0x5253075210160001ULL,
+    0x0100000154213812ULL, 0x1010521043805113ULL, 0x0001241016205381ULL,
+    0x1300200110000000ULL, 0x3201400120001000ULL, 0x0022002500031001ULL,
+    0x0101003200610242ULL, 0x1001353054503632ULL, 0x0153745202310012ULL,
+    0x1031002572315162ULL, 0x2300131010000000ULL, 0x0000010020002410ULL,
+    0x0100121024004200ULL, 0x1000210035502621ULL, 0x0000042107503312ULL,
+    0x2311242317421500ULL, 0x0121251564732421ULL, 0x2121651525731021ULL,
+    0x1150381052623141ULL, 0x1262351022313010ULL, 0x2620361001200000ULL,
+    0x1127003400010001ULL, 0x2000300123701410ULL, 0x3157310040001010ULL,
+    0x1000301027001631ULL, 0x2312007400560011ULL, 0x0000100021004210ULL,
+    0x1000200045202311ULL, 0x1000200045212320ULL, 0x0001120026132421ULL,
+    0x0401360014103131ULL, 0x1342056401530001ULL, 0x2735052210130002ULL,
+    0x1311264242761432ULL, 0x2311264342761432ULL, 0x1421162584103130ULL,
+    0x3001280012135734ULL, 0x1000010103542212ULL, 0x0261005200731001ULL,
+    0x2121754126204100ULL, 0x1223754126304210ULL, 0x0252753112610042ULL,
+    0x2531726215431200ULL, 0x1211473035201700ULL, 0x0031074302674221ULL,
+    0x1301075722632432ULL, 0x2351376724341132ULL, 0x1000000030002100ULL,
+    0x1001023100462123ULL, 0x0100000012613630ULL, 0x2131321017002301ULL,
+    0x1135215300420001ULL, 0x2115035400420011ULL, 0x1532464211310000ULL,
+    0x3520465112321000ULL, 0x1010420025751320ULL, 0x1513265217320012ULL,
+    0x0000001004322583ULL, 0x2512015200080001ULL, 0x0023016401820003ULL,
+    0x0002034310436182ULL, 0x1232014616480031ULL, 0x1483616216213140ULL,
+    0x1001648111743241ULL, 0x0003100300010000ULL, 0x4301100010000000ULL,
+    0x2312004101020000ULL, 0x2512003100750011ULL, 0x1211068300310012ULL,
+    0x3212542013000000ULL, 0x0000321054111330ULL, 0x1000200033001720ULL,
+    0x1420361157401322ULL, 0x1451018200540012ULL, 0x1532368501011002ULL,
+    0x1531468223502001ULL, 0x0243012600820071ULL, 0x4100410015703862ULL,
+    0x5271256348211100ULL, 0x2421475215438611ULL, 0x0000000000041032ULL,
+    0x2250300000011000ULL, 0x1453032100000001ULL, 0x0000250143212224ULL,
+    0x2464310120000000ULL, 0x0010010204613314ULL, 0x0002001302641053ULL,
+    0x1224016400530010ULL, 0x2142037400000100ULL, 0x1142237401100000ULL,
+    0x1321273036202301ULL, 0x4212574225301621ULL, 0x0141005303482231ULL,
+    0x2582120164000000ULL, 0x1510232114806231ULL, 0x1232248563221511ULL,
+    0x1252101030001000ULL, 0x2531101501030000ULL, 0x1100200057003420ULL,
+    0x2200241035411734ULL, 0x0101005402361372ULL, 0x2010540023601372ULL,
+    0x0000001108441352ULL, 0x3010130018461320ULL, 0x0100380136501131ULL,
+    0x0153036300520081ULL, 0x4341217300280134ULL, 0x1141007343280334ULL,
+    0x4000187513611341ULL, 0x2182451085202310ULL, 0x1200430016003210ULL,
+    0x0000113202570164ULL, 0x2414453131710060ULL, 0x0160008062441511ULL,
+    0x0152007381631001ULL, 0x0000000001011222ULL, 0x0000001000020123ULL,
+    0x2510576014002200ULL, 0x0002015602741513ULL, 0x1121064438422162ULL,
+    0x3100100001000000ULL, 0x2512644020300001ULL, 0x2512016500230101ULL,
+    0x2132121404670012ULL, 0x1800030202133151ULL, 0x0112138134521134ULL,
+    0x5152236801431002ULL, 0x0012515823631142ULL, 0x1413317800431002ULL,
+    0x0023003400121003ULL, 0x2241000500130001ULL, 0x4613015500300100ULL,
+    0x4713110031001000ULL, 0x0013000207034232ULL, 0x4310276020102000ULL,
+    0x0000005111161733ULL, 0x0211005610240070ULL, 0x2000520135602712ULL,
+    0x3630631037101300ULL, 0x2100110036022851ULL, 0x2530136428304210ULL,
+    0x1000131145202643ULL, 0x1111243416500040ULL, 0x0013243401650104ULL,
+    0x1000024203741143ULL, 0x1010400047503500ULL, 0x2232850030011000ULL,
+    0x2112163100850052ULL, 0x0613143132852521ULL, 0x2100210100000000ULL,
+    0x4262035102420116ULL, 0x1246037401310013ULL, 0x3461217404230212ULL,
+    0x0012002400120001ULL, 0x5101210020000000ULL, 0x1001003113410253ULL,
+    0x1232346534102000ULL, 0x2100230042622525ULL, 0x3162432522100500ULL,
+    0x3162432512310015ULL, 0x1000024323734615ULL, 0x2630520127001600ULL,
+    0x0000120046003138ULL, 0x3722481412014100ULL, 0x0232004500011002ULL,
+    0x2232004500011002ULL, 0x2000300116001323ULL, 0x0010200036012323ULL,
+    0x0133046410320001ULL, 0x0152012700021001ULL, 0x1623247101330002ULL,
+    0x3281610220100000ULL, 0x4300140163202181ULL, 0x3450638021001310ULL,
+    0x0152252100020004ULL, 0x1200471045302121ULL, 0x1132027301630010ULL,
+    0x3100170126202140ULL, 0x0101370016203141ULL, 0x1010320046701432ULL,
+    0x1373254106320241ULL, 0x3182252045013100ULL, 0x1631438422321000ULL,
+    0x2253003110000000ULL, 0x2653000000010000ULL, 0x1000000100231652ULL,
+    0x0161012300520141ULL, 0x2651232336010100ULL, 0x2162752021411000ULL,
+    0x3210010001000000ULL, 0x0100000200350122ULL, 0x0101046100060241ULL,
+    0x1000054100710123ULL, 0x0413164213570231ULL, 0x2100100000001000ULL,
+    0x1131046201310004ULL, 0x1001421026501540ULL, 0x0032465102540102ULL,
+    0x4632261024012000ULL, 0x0471134402030101ULL, 0x3200161073102153ULL,
+    0x2321163534411720ULL, 0x0825252111430001ULL, 0x1523824154003201ULL,
+    0x0010602043428161ULL, 0x0032157606812123ULL, 0x1532267611810023ULL,
+    0x1521136438762423ULL, 0x0000000115304222ULL, 0x0000160122344111ULL,
+    0x1471025214240002ULL, 0x2200134060001001ULL, 0x0131021510060002ULL,
+    0x0010310042303653ULL, 0x1323423103650001ULL, 0x0103132142351362ULL,
+    0x1123433112651302ULL, 0x2242135510610020ULL, 0x1362001400170002ULL,
+    0x2730161012601100ULL, 0x3731161002610100ULL, 0x0041012008614244ULL,
+    0x3001560083006131ULL, 0x3632530081106000ULL, 0x4512346126800101ULL,
+    0x6212373021810000ULL, 0x2672038100431002ULL, 0x1002067304840341ULL,
+    0x0143000010020000ULL, 0x0343011200010000ULL, 0x1543131000000000ULL,
+    0x2740340025211000ULL, 0x3252201010010000ULL, 0x5010200031002500ULL,
+    0x0000300041201611ULL, 0x0001320042424610ULL, 0x3341561201000000ULL,
+    0x6220260010101000ULL, 0x2630260020102000ULL, 0x1000240047101131ULL,
+    0x2125175236013100ULL, 0x0000020116824221ULL, 0x0010012106821431ULL,
+    0x1210461028501331ULL, 0x2221542010000100ULL, 0x0001220054001131ULL,
+    0x3411160030001100ULL, 0x0001000000411732ULL, 0x2741410230010001ULL,
+    0x2000524117322421ULL, 0x5212174134321032ULL, 0x2500321174222531ULL,
+    0x0115126201740023ULL, 0x0150473133602412ULL, 0x0000000000012201ULL,
+    0x0000000010003101ULL, 0x0143010100000000ULL, 0x0000001202410004ULL,
+    0x1001200050002411ULL, 0x0100001300150242ULL, 0x4000200032511412ULL,
+    0x1000451131201432ULL, 0x0001001614510423ULL, 0x1000100135201723ULL,
+    0x2531373021100000ULL, 0x2542037200211010ULL, 0x0000354113733112ULL,
+    0x5231234672201301ULL, 0x1001003108214513ULL, 0x1200323168401530ULL,
+    0x1300343217845110ULL, 0x0322010101000000ULL, 0x0101001200551312ULL,
+    0x1201125461003000ULL, 0x3010710024202461ULL, 0x1412013804523123ULL,
+    0x0241143345821411ULL, 0x1010000010000000ULL, 0x2343202010000000ULL,
+    0x4612024101000000ULL, 0x0161044203030100ULL, 0x0161005201040002ULL,
+    0x0112462434321541ULL, 0x1721323224611321ULL, 0x0001012735242461ULL,
+    0x3432184141002000ULL, 0x3410181042312143ULL,
+};
+
+const len_t corpus_len = sizeof(corpus) / sizeof(corpus[0]);
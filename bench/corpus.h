@@ -0,0 +1,9 @@
+#ifndef _BENCH_CORPUS_H
+#define _BENCH_CORPUS_H
+
+#include "shared.h"
+
+extern const board_t corpus[];
+extern const len_t corpus_len;
+
+#endif
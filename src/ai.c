@@ -0,0 +1,622 @@
+/**
+ * @file ai.c
+ * @brief Defines the expectimax search for recommending moves.
+ *
+ * @details This module defines an expectimax search over the packed game
+ * board for selecting the move with the highest expected value. Player
+ * nodes maximize over the moves in the four directions, and chance nodes
+ * average over the placement of the value 2 at each empty cell, which is
+ * the only value placed by the game logic.
+ *
+ * The leaves are evaluated with a heuristic precomputed for every possible
+ * row of the game board, such that a game board is evaluated with a lookup
+ * per row and column, or with the n-tuple network if one is set. Chance
+ * nodes whose cumulative probability falls below a threshold are evaluated
+ * directly, pruning the improbable subtrees, and the values of the other
+ * chance nodes are shared across the symmetric and transposed game boards
+ * through an optional transposition table.
+ *
+ * If a thread pool is set up, the search tree is expanded serially down to
+ * a fixed number of moves below the root, and the player nodes at that level
+ * are searched in parallel by the workers of the pool, sharing the same
+ * transposition table. The values of the nodes above are then combined
+ * serially by walking the expanded levels once more in the same order.
+ *
+ * For a time-budgeted search, the depth is increased iteratively until the
+ * deadline passes, which aborts the iteration in progress, and the move of
+ * the deepest completed iteration is selected.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ai.h"
+#include "logic.h"
+#include "ntuple.h"
+#include "pool.h"
+#include "stats.h"
+#include "table.h"
+#include "shared.h"
+#include "consts.h"
+
+// Stores the state shared across the nodes searched by a single thread,
+// occupying separate cache lines for the individual workers of the pool.
+// The deadline is the value of the monotonic clock in nanoseconds after
+// which the search is aborted, where 0 signifies the absence of any, and
+// the search is also aborted once the optional cancellation flag is set.
+typedef struct
+{
+    _Alignas(CACHE_LINE) TransTable *table;
+    const bool *cancel;
+    uint64_t deadline;
+    uint64_t nodes;
+    uint64_t hits;
+    uint64_t misses;
+    uint32_t ticks;
+    bool aborted;
+} Search;
+
+// Stores a player node at the level where the search is split across
+// the workers of the pool, along with its value once it is searched.
+typedef struct
+{
+    board_t board;
+    float prob;
+    float value;
+    uint8_t depth;
+} Task;
+
+// Stores the state of the expansion of the levels above the split, which
+// either collects the player nodes at the split level as the tasks, or
+// consumes the values of the searched tasks in the same order.
+typedef struct
+{
+    Task *tasks;
+    Search *searches;
+    uint32_t cnt;
+    uint64_t nodes;
+    bool collect;
+} Split;
+
+// Stores the thread pool for the parallel search, along with the tasks of
+// the current search and the search state of the individual workers.
+static Pool pool;
+static Task tasks[MAX_TASKS];
+static Search searches[MAX_THREADS];
+
+// Stores the precomputed heuristic value of every possible row of the game
+// board, which equally applies to the columns laid out as rows.
+static float row_scores[ROW_COUNT];
+
+// Stores the score accumulated for forming the tiles of every possible row,
+// and the n-tuple network evaluating the leaves, or NULL for the heuristic.
+static float row_totals[ROW_COUNT];
+static const Network *network;
+
+/**
+ * @brief Computes the heuristic value of an individual row.
+ *
+ * @details Rewards the empty cells and the adjacent equal tiles which can
+ * be merged, and penalizes the differences between the successive tiles,
+ * the rows which are not monotonic in either direction and the magnitude
+ * of the tiles, such that the larger tiles are kept together at an edge
+ * of the game board.
+ *
+ * @param row The packed row of the game board.
+ * @return The heuristic value of the row.
+ */
+static float score_row(row_t row)
+{
+    cell_t cells[BOARD_SIZE];
+    float sum = 0, mono_left = 0, mono_right = 0;
+    uint8_t empty = 0, merges = 0, run = 0, rough = 0;
+    cell_t prev = 0;
+
+    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    {
+        cells[i] = (row >> (i * CELL_BITS)) & CELL_MASK;
+        sum += powf(cells[i], 3.5f);
+
+        if (!cells[i])
+        {
+            ++empty;
+            continue;
+        }
+
+        // Accumulates the differences between the exponents of the
+        // successive tiles, skipping over the empty cells between them.
+        if (prev)
+            rough += cells[i] > prev ? cells[i] - prev : prev - cells[i];
+
+        // Counts the runs of equal tiles, where each run of
+        // n tiles contributes 1 + n to the number of merges.
+        if (cells[i] == prev)
+        {
+            ++run;
+            continue;
+        }
+
+        if (run)
+            merges += 1 + run;
+
+        prev = cells[i], run = 0;
+    }
+
+    if (run)
+        merges += 1 + run;
+
+    for (index_t i = 1; i < BOARD_SIZE; ++i)
+    {
+        float left = powf(cells[i - 1], 4), right = powf(cells[i], 4);
+
+        if (left > right)
+            mono_left += left - right;
+
+        else
+            mono_right += right - left;
+    }
+
+    return AI_BASE_SCORE + AI_EMPTY_WEIGHT * empty + AI_MERGE_WEIGHT * merges -
+           AI_MONO_WEIGHT * fminf(mono_left, mono_right) - AI_SMOOTH_WEIGHT * rough -
+           AI_SUM_WEIGHT * sum;
+}
+
+/**
+ * @brief Initializes the heuristic table for the search.
+ *
+ * @details The row transition tables must be initialized beforehand
+ * with init_move_tables for performing the moves during the search.
+ */
+void init_ai(void)
+{
+    for (uint32_t row = 0; row < ROW_COUNT; ++row)
+    {
+        row_scores[row] = score_row(row);
+        row_totals[row] = 0;
+
+        // As only the value 2 is placed, a tile of 2^n is always formed
+        // by merges gaining a score of (n - 1) * 2^n in total.
+        for (index_t i = 0; i < BOARD_SIZE; ++i)
+        {
+            cell_t cell = (row >> (i * CELL_BITS)) & CELL_MASK;
+            row_totals[row] += cell ? (float)(cell - 1) * (1u << cell) : 0;
+        }
+    }
+}
+
+/**
+ * @brief Sets the n-tuple network for evaluating the leaves of the search.
+ *
+ * @details The network estimates the score yet to be gained from a game
+ * board, to which the score accumulated on the game board is added, such
+ * that the score gained by the moves along the searched path is accounted
+ * for irrespective of the depth of the leaf.
+ *
+ * @param net Pointer to the Network struct, or NULL to evaluate the
+ * leaves with the heuristic.
+ */
+void set_network(const Network *net)
+{
+    network = net;
+}
+
+/**
+ * @brief Evaluates the packed game board with the heuristic table,
+ * or with the n-tuple network if one is set.
+ *
+ * @return Sum of the heuristic values of all the rows and columns, or the
+ * total score expected by the network at the end of the game.
+ */
+float evaluate_board(board_t board)
+{
+    if (network)
+    {
+        float score = evaluate_network(network, board);
+
+        for (index_t i = 0; i < BOARD_SIZE; ++i)
+            score += row_totals[(board >> (i * ROW_BITS)) & ROW_MASK];
+
+        return score;
+    }
+
+    board_t cols = transpose(board);
+    float score = 0;
+
+    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    {
+        score += row_scores[(board >> (i * ROW_BITS)) & ROW_MASK];
+        score += row_scores[(cols >> (i * ROW_BITS)) & ROW_MASK];
+    }
+
+    return score;
+}
+
+/**
+ * @brief Checks whether the search has been cancelled through the flag.
+ *
+ * @details The flag is set by another thread, and is read atomically
+ * without ordering as the search is only required to observe it eventually.
+ */
+static inline bool is_cancelled(const bool *cancel)
+{
+    return cancel && __atomic_load_n(cancel, __ATOMIC_RELAXED);
+}
+
+static float search_chance(Search *search, board_t board, uint8_t depth, float prob);
+
+/**
+ * @brief Computes the value of a player node as the maximum
+ * of the expected values of the moves in all the directions.
+ *
+ * @param search Pointer to the Search struct comprising the search state.
+ * @param board The packed game board.
+ * @param depth Number of moves remaining to be searched.
+ * @param prob Cumulative probability of reaching the node.
+ *
+ * @return The value of the node, or 0 if no move is possible
+ * or if the search has been aborted.
+ */
+static float search_player(Search *search, board_t board, uint8_t depth, float prob)
+{
+    float best = 0;
+    ++search->nodes;
+
+    // The clock is only read at regular intervals of nodes, as the
+    // nodes are searched much faster than the clock can be read.
+    if (search->deadline && !(++search->ticks % AI_CLOCK_INTERVAL))
+        search->aborted = clock_ns() > search->deadline || is_cancelled(search->cancel);
+
+    if (search->aborted)
+        return 0;
+
+    for (dir_t dir = 0; dir < DIR_CNT; ++dir)
+    {
+        board_t next = shift_board(board, dir);
+
+        if (next == board)
+            continue;
+
+        float value = search_chance(search, next, depth - 1, prob);
+
+        if (value > best)
+            best = value;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Computes the value of a chance node as the average of the values
+ * of placing the value 2 at each empty cell on the game board.
+ *
+ * @details The node is evaluated with the heuristic instead if the depth
+ * is exhausted or if the node is too improbable to affect the result. The
+ * value is looked up in the transposition table before searching the node
+ * if the table is available, and stored in it after the node is searched
+ * unless the search has been aborted in the meantime.
+ *
+ * @param search Pointer to the Search struct comprising the search state.
+ * @param board The packed game board.
+ * @param depth Number of moves remaining to be searched.
+ * @param prob Cumulative probability of reaching the node.
+ *
+ * @return The expected value of the node.
+ */
+static float search_chance(Search *search, board_t board, uint8_t depth, float prob)
+{
+    uint16_t mask = empty_mask(board);
+    uint8_t cnt = __builtin_popcount(mask);
+
+    ++search->nodes;
+
+    if (!depth || !cnt || prob < AI_PROB_CUTOFF)
+        return evaluate_board(board);
+
+    board_t key = 0;
+    float sum = 0;
+
+    if (search->table && depth >= TABLE_MIN_DEPTH)
+    {
+        key = canonical_board(board);
+
+        if (probe_table(search->table, key, depth, &sum))
+        {
+            ++search->hits;
+            return sum;
+        }
+
+        ++search->misses;
+    }
+
+    prob /= cnt;
+
+    // Places the value at each empty cell, iterating over the set bits.
+    for (; mask; mask &= mask - 1)
+    {
+        board_t tile = (board_t)1 << (__builtin_ctz(mask) * CELL_BITS);
+        sum += search_player(search, board | tile, depth, prob);
+    }
+
+    if (key && !search->aborted)
+        store_table(search->table, key, depth, sum / cnt);
+
+    return sum / cnt;
+}
+
+static float split_chance(Split *split, board_t board, uint8_t depth, float prob, uint8_t level);
+
+/**
+ * @brief Expands a player node above the split level of the search.
+ *
+ * @details Player nodes at the split level are collected as tasks, or
+ * replaced with the values of the tasks once they have been searched.
+ *
+ * @param split Pointer to the Split struct comprising the expansion state.
+ * @param board The packed game board.
+ * @param depth Number of moves remaining to be searched.
+ * @param prob Cumulative probability of reaching the node.
+ * @param level Number of moves remaining until the split level.
+ *
+ * @return The value of the node, which is only meaningful
+ * once the values of the tasks are being consumed.
+ */
+static float split_player(Split *split, board_t board, uint8_t depth, float prob, uint8_t level)
+{
+    if (!level)
+    {
+        if (!split->collect)
+            return split->tasks[split->cnt++].value;
+
+        split->tasks[split->cnt++] = (Task){board, prob, 0, depth};
+        return 0;
+    }
+
+    float best = 0;
+    split->nodes += split->collect;
+
+    for (dir_t dir = 0; dir < DIR_CNT; ++dir)
+    {
+        board_t next = shift_board(board, dir);
+
+        if (next == board)
+            continue;
+
+        float value = split_chance(split, next, depth - 1, prob, level);
+
+        if (value > best)
+            best = value;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Expands a chance node above the split level of the search.
+ *
+ * @details Follows the same conditions as the serial search for evaluating
+ * the node directly, such that the same nodes are expanded while collecting
+ * the tasks and while consuming their values.
+ *
+ * @param split Pointer to the Split struct comprising the expansion state.
+ * @param board The packed game board.
+ * @param depth Number of moves remaining to be searched.
+ * @param prob Cumulative probability of reaching the node.
+ * @param level Number of moves remaining until the split level.
+ *
+ * @return The expected value of the node, which is only meaningful
+ * once the values of the tasks are being consumed.
+ */
+static float split_chance(Split *split, board_t board, uint8_t depth, float prob, uint8_t level)
+{
+    uint16_t mask = empty_mask(board);
+    uint8_t cnt = __builtin_popcount(mask);
+
+    split->nodes += split->collect;
+
+    if (!depth || !cnt || prob < AI_PROB_CUTOFF)
+        return evaluate_board(board);
+
+    float sum = 0;
+    prob /= cnt;
+
+    for (; mask; mask &= mask - 1)
+    {
+        board_t tile = (board_t)1 << (__builtin_ctz(mask) * CELL_BITS);
+        sum += split_player(split, board | tile, depth, prob, level - 1);
+    }
+
+    return sum / cnt;
+}
+
+/**
+ * @brief Searches the player node of an individual task.
+ *
+ * @param ctx Pointer to the Split struct comprising the tasks.
+ * @param worker Index of the worker performing the task.
+ * @param index Index of the task.
+ */
+static void search_task(void *ctx, uint8_t worker, uint32_t index)
+{
+    Split *split = (Split *)ctx;
+    Task *task = &split->tasks[index];
+
+    task->value = search_player(&split->searches[worker], task->board, task->depth, task->prob);
+}
+
+/**
+ * @brief Sets up the thread pool for the parallel search.
+ *
+ * @param threads Number of threads searching in parallel, including the
+ * thread calling search_move, which must lie within [1, MAX_THREADS].
+ *
+ * @return Boolean value indicating whether the setup was successful.
+ */
+bool init_search_pool(uint8_t threads)
+{
+    return init_pool(&pool, threads);
+}
+
+/**
+ * @brief Stops the threads of the parallel search and frees the pool.
+ */
+void free_search_pool(void)
+{
+    free_pool(&pool);
+}
+
+/**
+ * @brief Searches for the best move on the packed game board to the
+ * specified depth.
+ *
+ * @details The search is split across the workers of the thread pool if
+ * it has been set up with multiple threads, and is performed serially on
+ * the calling thread otherwise.
+ *
+ * @param board The packed game board.
+ * @param depth Number of successive moves to be searched.
+ * @param table Pointer to the TransTable struct, or NULL.
+ * @param deadline Value of the monotonic clock in nanoseconds after
+ * which the search is aborted, or 0 to search without a deadline.
+ * @param cancel Pointer to the flag for cancelling the search, or NULL,
+ * which is only checked along with the deadline.
+ * @param aborted Pointer to store whether the search was aborted, in which
+ * case the move and its value in the result are not meaningful.
+ *
+ * @return SearchResult struct comprising the result of the search.
+ */
+static SearchResult search_depth(board_t board, uint8_t depth, TransTable *table,
+                                 uint64_t deadline, const bool *cancel, bool *aborted)
+{
+    SearchResult result = {.depth = depth};
+    Search search = {.table = table, .cancel = cancel, .deadline = deadline};
+
+    Split split = {.tasks = tasks, .searches = searches, .collect = true};
+    bool parallel = pool.cnt > 1;
+
+    // The split is raised for the shallow searches, such that the tasks
+    // still comprise the chance nodes stored in the transposition table.
+    uint8_t level = depth >= SEARCH_SPLIT + 2 ? SEARCH_SPLIT : 1;
+
+    // Collects the player nodes at the split level and searches them in
+    // parallel, before the values of the root moves are computed below.
+    if (parallel)
+    {
+        for (uint8_t i = 0; i < pool.cnt; ++i)
+            searches[i] = (Search){.table = table, .cancel = cancel, .deadline = deadline};
+
+        for (dir_t dir = 0; dir < DIR_CNT; ++dir)
+        {
+            board_t next = shift_board(board, dir);
+
+            if (next != board)
+                split_chance(&split, next, depth - 1, 1.0f, level);
+        }
+
+        run_pool(&pool, search_task, &split, split.cnt);
+
+        split.collect = false, split.cnt = 0;
+
+        for (uint8_t i = 0; i < pool.cnt; ++i)
+        {
+            search.nodes += searches[i].nodes;
+            search.hits += searches[i].hits;
+            search.misses += searches[i].misses;
+            search.aborted |= searches[i].aborted;
+        }
+
+        search.nodes += split.nodes;
+    }
+
+    for (dir_t dir = 0; dir < DIR_CNT; ++dir)
+    {
+        board_t next = shift_board(board, dir);
+
+        if (next == board)
+            continue;
+
+        float value = parallel ? split_chance(&split, next, depth - 1, 1.0f, level)
+                               : search_chance(&search, next, depth - 1, 1.0f);
+
+        if (!result.found || value > result.value)
+            result = (SearchResult){dir, true, value, 0, depth};
+    }
+
+    if (table)
+        table->hits += search.hits, table->misses += search.misses;
+
+    *aborted = search.aborted;
+
+    result.nodes = search.nodes;
+    return result;
+}
+
+/**
+ * @brief Searches for the best move on the packed game board.
+ *
+ * @param board The packed game board.
+ * @param depth Number of successive moves to be searched, which
+ * must lie within the range [1, MAX_AI_DEPTH].
+ * @param table Pointer to the TransTable struct for sharing the values
+ * of the game boards across the searches, or NULL to search without it.
+ *
+ * @return SearchResult struct comprising the best move and its expected
+ * value along with the number of nodes searched, where the move is only
+ * found if any move is possible on the game board.
+ */
+SearchResult search_move(board_t board, uint8_t depth, TransTable *table)
+{
+    bool aborted;
+    return search_depth(board, depth, table, 0, NULL, &aborted);
+}
+
+/**
+ * @brief Searches for the best move on the packed game board within
+ * the specified time budget.
+ *
+ * @details Searches the game board with increasing depths until the time
+ * budget runs out, and selects the move of the deepest completed search.
+ * The search with a depth of 1 is always completed irrespective of the
+ * budget, such that a move is found whenever any move is possible.
+ *
+ * The searches with the lower depths populate the transposition table
+ * with the values reused by the deeper searches, which mostly offsets
+ * searching the upper levels of the tree repeatedly.
+ *
+ * The search can be cancelled from another thread by setting the
+ * cancellation flag, in which case the deepest search completed until
+ * then is returned.
+ *
+ * @param board The packed game board.
+ * @param budget Time budget of the search in nanoseconds.
+ * @param table Pointer to the TransTable struct, or NULL.
+ * @param cancel Pointer to the flag for cancelling the search, or NULL.
+ *
+ * @return SearchResult struct comprising the best move of the deepest
+ * completed search and the depth reached, along with the number of nodes
+ * searched across all the iterations including the aborted one.
+ */
+SearchResult search_timed(board_t board, uint64_t budget, TransTable *table, const bool *cancel)
+{
+    uint64_t deadline = clock_ns() + budget, nodes = 0;
+    SearchResult best = {0};
+    bool aborted = false;
+
+    for (uint8_t depth = 1; depth <= MAX_AI_DEPTH && !aborted; ++depth)
+    {
+        SearchResult result =
+            search_depth(board, depth, table, depth > 1 ? deadline : 0, cancel, &aborted);
+        nodes += result.nodes;
+
+        if (!aborted)
+            best = result;
+
+        // Deeper searches cannot find a move if none is found at the first
+        // depth, and the budget may have run out or the search cancelled.
+        if (!best.found || clock_ns() > deadline || is_cancelled(cancel))
+            break;
+    }
+
+    best.nodes = nodes;
+    return best;
+}
@@ -54,6 +54,9 @@ const char *lost_dialog_txt[] = {"You lost the game!", "Better luck next time...
 const len_t win_dialog_txt_len = 1;
 const len_t lost_dialog_txt_len = 2;
 
+// Names of the directions of moves, indexed by the direction indices.
+const char *dir_names[] = {"left", "right", "up", "down"};
+
 // The following constants store the indices of the screen handlers
 // associated with individual options in the main and pause menu.
 
@@ -0,0 +1,221 @@
+/**
+ * @file grid.c
+ * @brief Defines the game logic kernels for the variable-size game boards.
+ *
+ * @details This module defines the tile operations for the game boards of
+ * sizes other than the default size, which are stored as row-major arrays
+ * of cells instead of the packed representation. The kernels are generated
+ * at compile time for each supported size, such that the loops over the
+ * cells have constant bounds and are fully unrolled, and are dispatched
+ * through a table indexed by the size of the game board.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "grid.h"
+#include "shared.h"
+#include "consts.h"
+
+// The game board embedded in the Game struct must accommodate the largest size.
+_Static_assert(sizeof(((Game *)0)->grid) >= MAX_BOARD_SIZE * MAX_BOARD_SIZE,
+               "Game struct cannot hold the largest game board");
+
+// Requests the complete unrolling of the loop that follows, which is
+// possible as the bounds of the loops within the kernels are constant.
+#define UNROLL _Pragma("GCC unroll 64")
+
+// Stores the kernels specialized for an individual size of the game board.
+typedef struct
+{
+    MoveResult (*slide)(cell_t *grid, dir_t dir, cell_t *max_val);
+    uint64_t (*empty)(const cell_t *grid);
+    uint8_t (*legal)(const cell_t *grid);
+} GridKernel;
+
+/**
+ * Defines the kernels for the game board of the specified size, comprising
+ * the following functions suffixed with the size:
+ *
+ * - slide_line: Merges and moves the tiles within the line of cells starting
+ *   at the specified cell and spaced by the specified step in a single pass,
+ *   in the same manner as the line kernel for the packed game board. As each
+ *   cell occupies a complete byte, the tiles are merged without the limit of
+ *   the 4-bit cells of the packed game board.
+ *
+ * - move_grid: Moves the tiles on the game board in the specified direction
+ *   by sliding each row or column, starting from the edge in the direction.
+ *
+ * - empty_mask: Computes the mask of the empty cells on the game board.
+ *
+ * - legal_moves: Computes the mask of the directions in which the tiles can
+ *   be moved, by checking each pair of adjacent cells for an empty cell
+ *   followed by a tile, or a pair of equal tiles which can be merged.
+ */
+#define DEFINE_GRID_KERNELS(N)                                                      \
+    static inline void slide_line_##N(                                              \
+        cell_t *cells, index_t step, MoveResult *result, cell_t *max_val)           \
+    {                                                                               \
+        cell_t src[N], pending = 0;                                                 \
+        index_t len = 0;                                                            \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N; ++i)                                      \
+            src[i] = cells[i * step];                                               \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N; ++i)                                      \
+        {                                                                           \
+            if (!src[i])                                                            \
+                continue;                                                           \
+                                                                                    \
+            else if (src[i] != pending)                                             \
+            {                                                                       \
+                if (pending)                                                        \
+                    cells[len++ * step] = pending;                                  \
+                                                                                    \
+                pending = src[i];                                                   \
+                continue;                                                           \
+            }                                                                       \
+                                                                                    \
+            cells[len++ * step] = ++pending;                                        \
+                                                                                    \
+            if (pending > *max_val)                                                 \
+                *max_val = pending;                                                 \
+                                                                                    \
+            result->score += (score_t)1 << pending;                                  \
+            ++result->merges;                                                       \
+                                                                                    \
+            pending = 0;                                                            \
+        }                                                                           \
+                                                                                    \
+        if (pending)                                                                \
+            cells[len++ * step] = pending;                                          \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N; ++i)                                      \
+        {                                                                           \
+            if (i >= len)                                                           \
+                cells[i * step] = 0;                                                \
+                                                                                    \
+            result->changed |= cells[i * step] != src[i];                           \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static MoveResult move_grid_##N(cell_t *grid, dir_t dir, cell_t *max_val)       \
+    {                                                                               \
+        MoveResult result = {0};                                                    \
+                                                                                    \
+        /* Defines the offset of the first cell of each line and the step */        \
+        /* between the subsequent cells based on the direction.           */        \
+        index_t start = 0, offset = 1, step = 1;                                    \
+                                                                                    \
+        if (dir == DIR_LEFT)                                                        \
+            offset = N;                                                             \
+                                                                                    \
+        else if (dir == DIR_RIGHT)                                                  \
+            start = N - 1, offset = N, step = -1;                                   \
+                                                                                    \
+        else if (dir == DIR_UP)                                                     \
+            step = N;                                                               \
+                                                                                    \
+        else                                                                        \
+            start = N * (N - 1), step = -N;                                         \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N; ++i)                                      \
+            slide_line_##N(grid + start + i * offset, step, &result, max_val);      \
+                                                                                    \
+        return result;                                                              \
+    }                                                                               \
+                                                                                    \
+    static uint64_t empty_mask_##N(const cell_t *grid)                              \
+    {                                                                               \
+        uint64_t mask = 0;                                                          \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N * N; ++i)                                  \
+            mask |= (uint64_t)!grid[i] << i;                                        \
+                                                                                    \
+        return mask;                                                                \
+    }                                                                               \
+                                                                                    \
+    static uint8_t legal_moves_##N(const cell_t *grid)                              \
+    {                                                                               \
+        uint8_t mask = 0;                                                           \
+        cell_t a, b;                                                                \
+                                                                                    \
+        UNROLL for (index_t i = 0; i < N; ++i)                                      \
+        {                                                                           \
+            UNROLL for (index_t j = 0; j < N - 1; ++j)                              \
+            {                                                                       \
+                a = grid[i * N + j], b = grid[i * N + j + 1];                       \
+                                                                                    \
+                mask |= (((!a && b) || (a && a == b)) << DIR_LEFT) |                \
+                        (((a && !b) || (a && a == b)) << DIR_RIGHT);                \
+                                                                                    \
+                a = grid[j * N + i], b = grid[(j + 1) * N + i];                     \
+                                                                                    \
+                mask |= (((!a && b) || (a && a == b)) << DIR_UP) |                  \
+                        (((a && !b) || (a && a == b)) << DIR_DOWN);                 \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        return mask;                                                                \
+    }
+
+DEFINE_GRID_KERNELS(3)
+DEFINE_GRID_KERNELS(5)
+DEFINE_GRID_KERNELS(6)
+DEFINE_GRID_KERNELS(7)
+DEFINE_GRID_KERNELS(8)
+
+#define GRID_KERNEL(N) {move_grid_##N, empty_mask_##N, legal_moves_##N}
+
+// Stores the kernels indexed by the size of the game board. The default size
+// is excluded as the associated game board is stored in the packed form.
+static const GridKernel kernels[MAX_BOARD_SIZE + 1] = {
+    [3] = GRID_KERNEL(3),
+    [5] = GRID_KERNEL(5),
+    [6] = GRID_KERNEL(6),
+    [7] = GRID_KERNEL(7),
+    [8] = GRID_KERNEL(8),
+};
+
+/**
+ * @brief Moves the tiles on the game board in the specified direction.
+ *
+ * @param grid Pointer to the game board.
+ * @param size Number of rows and columns in the game board.
+ * @param dir Index of the direction of the move.
+ * @param max_val Pointer to the maximum value on the game board,
+ * which is updated if exceeded by any of the merged tiles.
+ *
+ * @return MoveResult struct comprising the score gained, the number of
+ * merges and whether the game board was changed by the operation.
+ */
+MoveResult move_grid(cell_t *grid, uint8_t size, dir_t dir, cell_t *max_val)
+{
+    return kernels[size].slide(grid, dir, max_val);
+}
+
+/**
+ * @brief Computes the mask of the empty cells on the game board.
+ *
+ * @param grid Pointer to the game board.
+ * @param size Number of rows and columns in the game board.
+ *
+ * @return Mask with the bits set at the indices of the empty cells.
+ */
+uint64_t grid_empty_mask(const cell_t *grid, uint8_t size)
+{
+    return kernels[size].empty(grid);
+}
+
+/**
+ * @brief Computes the mask of the moves which change the game board.
+ *
+ * @param grid Pointer to the game board.
+ * @param size Number of rows and columns in the game board.
+ *
+ * @return Mask with the bits set at the indices of the legal directions.
+ */
+uint8_t grid_legal_moves(const cell_t *grid, uint8_t size)
+{
+    return kernels[size].legal(grid);
+}
@@ -12,14 +12,169 @@
 #include <stdbool.h>
 
 #include "logic.h"
+#include "handlers.h"
+#include "hint.h"
+#include "stats.h"
 #include "shared.h"
 #include "consts.h"
 
 #include "interface/core.h"
 #include "interface/board.h"
 #include "interface/menu.h"
+#include "interface/shared.h"
 
 Game game;
+FrameStats frame_stats;
+
+// Stores the latency statistics if they are requested, or NULL otherwise.
+LatencyStats *latency_stats;
+
+// Stores the hint for the current game board once it has been received
+// from the background worker, and whether it is still being awaited.
+static SearchResult hint;
+static bool hint_ready, hint_awaited;
+
+/**
+ * @brief Performs the move associated with the specified arrow key.
+ *
+ * @details A random value is only placed on the game
+ * board if it is changed by the move.
+ *
+ * @param input The key associated with the move.
+ * @return Boolean value indicating whether the game board was changed.
+ */
+static bool play_move(input_t input)
+{
+    dir_t dir;
+
+    switch (input)
+    {
+    case KEY_LEFT:
+        dir = DIR_LEFT;
+        break;
+
+    case KEY_RIGHT:
+        dir = DIR_RIGHT;
+        break;
+
+    case KEY_UP:
+        dir = DIR_UP;
+        break;
+
+    case KEY_DOWN:
+        dir = DIR_DOWN;
+        break;
+
+    default:
+        return false;
+    }
+
+    uint64_t start = latency_stats ? clock_ns() : 0;
+
+    if (!move_board(&game, dir).changed)
+        return false;
+
+    place_random(&game);
+
+    if (latency_stats)
+        record_sample(&latency_stats->logic, clock_ns() - start);
+
+    return true;
+}
+
+/**
+ * @brief Discards the hint, cancelling its search if it is in progress.
+ */
+static void discard_hint(void)
+{
+    if (hint_awaited)
+        cancel_hint();
+
+    hint_ready = hint_awaited = false;
+}
+
+/**
+ * @brief Reads the next key while polling for the awaited hint.
+ *
+ * @details Blocks on the input as usual unless a hint is awaited, in which
+ * case the input is read with a short timeout such that the result of the
+ * worker is picked up as soon as it is ready, without ever waiting for it.
+ *
+ * @return The key which was read, or ERR if the hint was received and
+ * has to be displayed.
+ */
+static input_t read_key(void)
+{
+    input_t input;
+
+    if (!hint_awaited)
+        return getch();
+
+    timeout(HINT_POLL);
+
+    while ((input = getch()) == (input_t)ERR)
+    {
+        if (take_hint(game.board, &hint))
+        {
+            hint_ready = true, hint_awaited = false;
+            break;
+        }
+    }
+
+    timeout(-1);
+    return input;
+}
+
+/**
+ * @brief Records the number of moves performed for a single frame.
+ * @param moves Number of moves performed before the frame was displayed.
+ */
+static void record_batch(len_t moves)
+{
+    ++frame_stats.frames;
+    frame_stats.moves += moves;
+
+    if (moves > frame_stats.max_batch)
+        frame_stats.max_batch = moves;
+
+    ++frame_stats.batches[moves < MAX_BATCH ? moves : MAX_BATCH];
+}
+
+/**
+ * @brief Displays a frame of the game board.
+ *
+ * @details If the latency statistics are requested, the time taken for
+ * staging and committing the frame, along with the overall time since the
+ * first key of the frame was read, are recorded, and the statistics of the
+ * preceding frames are displayed in an overlay.
+ *
+ * @param wctx Pointer to the WinContext struct comprising window data.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ * @param start Time at which the first key of the frame was read.
+ */
+static void display_frame(WinContext *wctx, Dimension *scr_dim, uint64_t start)
+{
+    if (!latency_stats)
+    {
+        show_board(wctx, &game, hint_ready ? &hint : NULL, scr_dim);
+        return;
+    }
+
+    uint64_t staged, render_start = clock_ns();
+
+    stage_board(wctx, &game, hint_ready ? &hint : NULL, scr_dim);
+    show_stats_overlay(wctx, latency_stats);
+
+    staged = clock_ns();
+    doupdate();
+
+    uint64_t flushed = clock_ns();
+
+    record_sample(&latency_stats->render, staged - render_start);
+    record_sample(&latency_stats->flush, flushed - staged);
+    record_sample(&latency_stats->total, flushed - start);
+}
 
 /**
  * @brief Handles the main menu interface.
@@ -59,7 +214,13 @@ handler_t handle_main_menu(Dimension *scr_dim)
             break;
 
         case KEY_RESIZE:
-            return HDL_MAIN_MENU;
+            debounce_resize();
+
+            if (!read_screen_dim(scr_dim, game.size))
+                return HDL_MAIN_MENU;
+
+            resize_main_menu(&wctx, scr_dim);
+            break;
         }
 
         // Updates the selection and displays the menu.
@@ -109,7 +270,13 @@ handler_t handle_pause_menu(Dimension *scr_dim)
             break;
 
         case KEY_RESIZE:
-            return HDL_PAUSE_MENU;
+            debounce_resize();
+
+            if (!read_screen_dim(scr_dim, game.size))
+                return HDL_PAUSE_MENU;
+
+            resize_pause_menu(&wctx, scr_dim);
+            break;
 
         // Pressing the ESC key redirects back to the game window.
         case ASCII_ESC:
@@ -137,6 +304,14 @@ handler_t handle_pause_menu(Dimension *scr_dim)
  * placement, and game over condition check at each move during the
  * gameplay.
  *
+ * The keys pending in the input queue are drained without blocking and the
+ * associated moves are performed back to back, such that the game board is
+ * only displayed once for a burst of keys instead of after each move.
+ *
+ * The hint for the next move is searched by the background worker on
+ * request, and is displayed once it is received while the input continues
+ * to be handled. The hint is discarded as soon as the game board changes.
+ *
  * @param scr_dim Pointer to the Dimension struct comprising the
  * screen dimensions.
  *
@@ -149,57 +324,80 @@ handler_t handle_game_board(Dimension *scr_dim)
     Dimension dim;
 
     wctx.dimension = &dim;
-    init_game_win(&wctx, scr_dim);
+    init_game_win(&wctx, scr_dim, game.size);
 
     if (!game.init)
         setup_game(&game);
 
-    // The 'iskey' stores whether the input is the up or left
-    // arrow key, to determine the direction of operation.
-
     input_t input = 0;
-    bool iskey, isempty, operated;
+    uint64_t start;
+    len_t moves;
 
     // Displays the game board and handles the game mechanics
     // until the ESC key is pressed to open the pause menu.
     do
     {
-        operated = false, isempty = true;
-        iskey = input == KEY_UP || input == KEY_LEFT;
+        moves = 0;
+        start = latency_stats ? clock_ns() : 0;
 
-        switch (input)
+        timeout(0);
+
+        // Handles the keys until the input queue is drained, or until the
+        // game ends or the ESC key is pressed, before displaying the frame.
+        do
         {
-        case KEY_UP:
-        case KEY_DOWN:
-            operated |= add_vertical(&game, iskey);
-            operated |= move_vertical(&game, iskey);
-            break;
+            if (input == KEY_HINT)
+            {
+                discard_hint();
+                hint_awaited = is_packed(&game) && request_hint(game.board);
+                continue;
+            }
 
-        case KEY_LEFT:
-        case KEY_RIGHT:
-            operated |= add_horizontal(&game, iskey);
-            operated |= move_horizontal(&game, iskey);
-            break;
+            if (input != KEY_RESIZE)
+            {
+                if (play_move(input))
+                {
+                    discard_hint();
+                    ++moves;
+                }
 
-        case KEY_RESIZE:
-            return HDL_GAME_WIN;
-        }
+                continue;
+            }
+
+            debounce_resize();
+
+            if (!read_screen_dim(scr_dim, game.size))
+            {
+                timeout(-1);
+                discard_hint();
+                return HDL_GAME_WIN;
+            }
+
+            resize_game_win(&wctx, scr_dim);
+
+        } while (!is_game_over(&game) && game.max_val != TARGET &&
+                 (input = getch()) != (input_t)ERR && input != ASCII_ESC);
 
-        // Random value is only placed if any operations are performed.
-        if (operated)
-            isempty = place_random(&game);
+        timeout(-1);
 
-        show_board(&wctx, &game, scr_dim);
+        record_batch(moves);
+        display_frame(&wctx, scr_dim, start);
 
         // Terminates the game if either of the termintation conditions are met.
-        if (is_game_over(&game, isempty) || game.max_val == TARGET)
+        if (is_game_over(&game) || game.max_val == TARGET)
         {
+            discard_hint();
             game.init = false;
             return HDL_END_GAME_DIALOG;
         }
 
-    } while ((input = getch()) != ASCII_ESC);
+        // The ESC key may have been read while draining the input queue.
+        if (input == ASCII_ESC)
+            break;
+
+    } while ((input = read_key()) != ASCII_ESC);
 
+    discard_hint();
     return HDL_PAUSE_MENU;
 }
 
@@ -228,9 +426,16 @@ handler_t handle_end_game_dialog(Dimension *scr_dim)
     // Displays the dialog until the RETURN key is pressed
     // signifying the OK button press.
 
+    // The dialog only comprises text on the standard screen, and is
+    // displayed again from scratch once the resize events settle.
     while ((input = getch()) != ASCII_LF)
+    {
         if (input == KEY_RESIZE)
+        {
+            debounce_resize();
             return HDL_END_GAME_DIALOG;
+        }
+    }
 
     return HDL_MAIN_MENU;
 }
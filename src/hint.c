@@ -0,0 +1,216 @@
+/**
+ * @file hint.c
+ * @brief Defines the background worker for searching the hints.
+ *
+ * @details This module defines a worker thread which searches for the best
+ * move on the game board on behalf of the TUI, such that the input handling
+ * continues uninterrupted during the search.
+ *
+ * The TUI posts the game board as a request and polls for the result, and
+ * the worker picks up the latest request and posts back its result. Both
+ * are handed over under a mutex, and the search in progress is cancelled
+ * through an atomic flag whenever the game board changes or another hint
+ * is requested, in which case its result is discarded.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hint.h"
+#include "ai.h"
+#include "table.h"
+#include "shared.h"
+#include "consts.h"
+
+// Stores the state of the worker thread, where the request is the game board
+// posted by the TUI, and the result is handed back along with the game board
+// it was searched for. The cancellation flag is also read by the search
+// without holding the lock.
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    TransTable table;
+
+    board_t request;
+    board_t board;
+    SearchResult result;
+
+    bool pending;
+    bool ready;
+    bool cancel;
+    bool stop;
+    bool running;
+} HintWorker;
+
+static HintWorker hints;
+
+/**
+ * @brief Entry point of the worker thread.
+ *
+ * @details Precomputes the heuristic table for the search on the worker
+ * thread, keeping it off the startup of the TUI, and searches each request
+ * until the worker is stopped. The result of a search is only posted if
+ * no other request or cancellation arrived in the meantime.
+ */
+static void *run_hints(void *arg)
+{
+    (void)arg;
+    init_ai();
+
+    pthread_mutex_lock(&hints.lock);
+
+    while (true)
+    {
+        while (!hints.pending && !hints.stop)
+            pthread_cond_wait(&hints.wake, &hints.lock);
+
+        if (hints.stop)
+            break;
+
+        board_t board = hints.request;
+
+        hints.pending = false;
+        __atomic_store_n(&hints.cancel, false, __ATOMIC_RELAXED);
+
+        pthread_mutex_unlock(&hints.lock);
+
+        SearchResult result =
+            search_timed(board, (uint64_t)HINT_BUDGET * 1000000, &hints.table, &hints.cancel);
+
+        pthread_mutex_lock(&hints.lock);
+
+        if (!__atomic_load_n(&hints.cancel, __ATOMIC_RELAXED) && !hints.pending)
+        {
+            hints.board = board, hints.result = result;
+            hints.ready = true;
+        }
+    }
+
+    pthread_mutex_unlock(&hints.lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the worker thread for searching the hints.
+ * @return Boolean value indicating whether the worker was started.
+ */
+bool start_hints(void)
+{
+    if (!init_table(&hints.table, (size_t)HINT_TABLE << 20))
+        return false;
+
+    pthread_mutex_init(&hints.lock, NULL);
+    pthread_cond_init(&hints.wake, NULL);
+
+    if (pthread_create(&hints.thread, NULL, run_hints, NULL))
+    {
+        pthread_mutex_destroy(&hints.lock);
+        pthread_cond_destroy(&hints.wake);
+        free_table(&hints.table);
+
+        return false;
+    }
+
+    hints.running = true;
+    return true;
+}
+
+/**
+ * @brief Stops the worker thread, cancelling the search in progress.
+ */
+void stop_hints(void)
+{
+    if (!hints.running)
+        return;
+
+    pthread_mutex_lock(&hints.lock);
+
+    hints.stop = true;
+    __atomic_store_n(&hints.cancel, true, __ATOMIC_RELAXED);
+
+    pthread_cond_signal(&hints.wake);
+    pthread_mutex_unlock(&hints.lock);
+
+    pthread_join(hints.thread, NULL);
+
+    pthread_mutex_destroy(&hints.lock);
+    pthread_cond_destroy(&hints.wake);
+    free_table(&hints.table);
+
+    hints.running = false;
+}
+
+/**
+ * @brief Requests a hint for the specified game board.
+ *
+ * @details Replaces any pending request or result, and cancels the
+ * search in progress such that the worker proceeds to this request.
+ *
+ * @param board The packed game board.
+ * @return Boolean value indicating whether the hint was requested,
+ * which is not the case if the worker is not running.
+ */
+bool request_hint(board_t board)
+{
+    if (!hints.running)
+        return false;
+
+    pthread_mutex_lock(&hints.lock);
+
+    hints.request = board;
+    hints.pending = true, hints.ready = false;
+    __atomic_store_n(&hints.cancel, true, __ATOMIC_RELAXED);
+
+    pthread_cond_signal(&hints.wake);
+    pthread_mutex_unlock(&hints.lock);
+
+    return true;
+}
+
+/**
+ * @brief Cancels the pending request and the search in progress,
+ * and discards any result which has not been taken yet.
+ */
+void cancel_hint(void)
+{
+    if (!hints.running)
+        return;
+
+    pthread_mutex_lock(&hints.lock);
+
+    hints.pending = false, hints.ready = false;
+    __atomic_store_n(&hints.cancel, true, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&hints.lock);
+}
+
+/**
+ * @brief Takes the result of the hint for the specified game board.
+ *
+ * @param board The packed game board, which must match the game
+ * board the result was searched for.
+ * @param result Pointer to store the result if it is available.
+ *
+ * @return Boolean value indicating whether the result was taken.
+ */
+bool take_hint(board_t board, SearchResult *result)
+{
+    if (!hints.running)
+        return false;
+
+    pthread_mutex_lock(&hints.lock);
+
+    bool taken = hints.ready && hints.board == board;
+
+    if (taken)
+    {
+        *result = hints.result;
+        hints.ready = false;
+    }
+
+    pthread_mutex_unlock(&hints.lock);
+    return taken;
+}
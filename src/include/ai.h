@@ -0,0 +1,20 @@
+#ifndef _AI_H
+#define _AI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "shared.h"
+#include "table.h"
+#include "ntuple.h"
+
+void init_ai(void);
+bool init_search_pool(uint8_t threads);
+void free_search_pool(void);
+void set_network(const Network *net);
+
+float evaluate_board(board_t board);
+SearchResult search_move(board_t board, uint8_t depth, TransTable *table);
+SearchResult search_timed(board_t board, uint64_t budget, TransTable *table, const bool *cancel);
+
+#endif
@@ -4,8 +4,36 @@
 #include <stdlib.h>
 #include "shared.h"
 
+// Default size of the game board, which is also the size of the game
+// board stored in the packed form. Other sizes within the supported
+// range are stored as arrays of cells.
 #define BOARD_SIZE 4
-#define TARGET 2048
+#define MIN_BOARD_SIZE 3
+#define MAX_BOARD_SIZE 8
+
+// Exponent of the target tile value, i.e. 2^11 = 2048.
+#define TARGET 11
+
+// Number of bits occupied by an individual cell in the packed game board.
+#define CELL_BITS 4
+#define CELL_MASK 0xF
+
+// Largest exponent of a tile reachable on the largest game board, as only
+// the value 2 is placed and the tiles of a full game board of n cells sum
+// to less than 2^(n + 2). The cells of the game boards of the other sizes
+// are not limited to 4 bits, and can hold any tile up to this value.
+//
+// The 64-bit score covers every game up to a tile of 2^57, whose score is
+// below 2^63. As each move places a single 2, reaching it takes over 2^55
+// moves, such that neither the score wraps nor a merge into a tile beyond
+// 2^63, whose score would not fit, occurs within any game actually played.
+#define MAX_TILE (MAX_BOARD_SIZE * MAX_BOARD_SIZE + 1)
+
+// Number of bits occupied by an individual row in the packed game
+// board, and the number of distinct values a row can comprise.
+#define ROW_BITS (CELL_BITS * BOARD_SIZE)
+#define ROW_MASK 0xFFFF
+#define ROW_COUNT (1 << ROW_BITS)
 
 #define MIN_HEIGHT 25
 #define MIN_WIDTH 80
@@ -14,8 +42,27 @@
 #define CELL_HEIGHT 3
 #define CELL_WIDTH 8
 
-#define BOARD_HEIGHT (CELL_HEIGHT + 1) * BOARD_SIZE + 1
-#define BOARD_WIDTH (CELL_WIDTH + 1) * BOARD_SIZE + 1
+#define BOARD_HEIGHT(size) ((CELL_HEIGHT + 1) * (size) + 1)
+#define BOARD_WIDTH(size) ((CELL_WIDTH + 1) * (size) + 1)
+
+// Number of rows required around the game board for the score.
+#define BOARD_MARGIN 6
+
+// Interval in milliseconds within which the successive resize
+// events are coalesced into a single relayout of the screen.
+#define RESIZE_DEBOUNCE 50
+
+// Number of moves per frame tracked individually in the frame statistics,
+// beyond which the frames are tracked together in the last bucket.
+#define MAX_BATCH 16
+
+// Number of sub-buckets per power of 2 in the latency histograms, as the
+// base-2 logarithm, and the resulting number of buckets for 64-bit values.
+#define HIST_SUB_BITS 3
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS + 1) << HIST_SUB_BITS)
+
+// Number of rows occupied by the statistics overlay at the top of the screen.
+#define STATS_ROWS 4
 
 // Index values used to identify the handler functions
 // associated with the corresponding in-game screens.
@@ -25,8 +72,102 @@
 #define HDL_GAME_WIN 3
 #define HDL_END_GAME_DIALOG 4
 
+// Index values used to identify the windows associated with the
+// corresponding in-game screens, which are created only once.
+#define WIN_MAIN_MENU 0
+#define WIN_PAUSE_MENU 1
+#define WIN_GAME_BOARD 2
+#define WIN_CNT 3
+
+// Index values used to identify the directions of moves on the game board.
+#define DIR_LEFT 0
+#define DIR_RIGHT 1
+#define DIR_UP 2
+#define DIR_DOWN 3
+#define DIR_CNT 4
+
+// Default and maximum depth of the expectimax search, as the
+// number of successive moves searched ahead of the game board.
+#define AI_DEPTH 3
+#define MAX_AI_DEPTH 8
+
+// Number of player nodes searched between the successive
+// reads of the clock during a time-budgeted search.
+#define AI_CLOCK_INTERVAL 1024
+
+// Cumulative probability of the tile placements leading to a
+// chance node, below which it is evaluated instead of expanded.
+#define AI_PROB_CUTOFF 0.0001f
+
+// Maximum number of threads for the parallel search.
+#define MAX_THREADS 64
+
+// Number of moves below the root at which the parallel search is split into
+// tasks, and the resulting maximum number of tasks, as each move is followed
+// by at most 16 placements in each of the 4 directions.
+#define SEARCH_SPLIT 2
+#define MAX_TASKS 4096
+
+// Time budget of the search for the hints in milliseconds, the memory
+// budget of its transposition table in mebibytes, and the interval in
+// milliseconds at which the pending hint is polled for while idle.
+#define HINT_BUDGET 20
+#define HINT_TABLE 16
+#define HINT_POLL 5
+
+// Number of entries per bucket of the transposition table, each bucket
+// occupying a single cache line of the specified size in bytes.
+#define TABLE_WAYS 4
+#define CACHE_LINE 64
+
+// Default and maximum memory budget of the transposition table in
+// mebibytes, where the maximum of 1 TiB keeps the size in bytes within
+// the range of size_t.
+#define TABLE_BUDGET 64
+#define MAX_TABLE_BUDGET (1u << 20)
+
+// Minimum remaining depth of the chance nodes stored in the transposition
+// table, below which the nodes are cheaper to search than to look up.
+#define TABLE_MIN_DEPTH 1
+
+// Weights of the features in the heuristic evaluation of the game board,
+// where the constant offset keeps the value of any ongoing game positive.
+#define AI_BASE_SCORE 200000.0f
+#define AI_EMPTY_WEIGHT 270.0f
+#define AI_MERGE_WEIGHT 700.0f
+#define AI_MONO_WEIGHT 47.0f
+#define AI_SMOOTH_WEIGHT 1000.0f
+#define AI_SUM_WEIGHT 11.0f
+
+// Number of the tuples of cells in the n-tuple network, the number of cells
+// covered by each tuple, and the resulting number of weights per tuple.
+#define NTUPLE_CNT 4
+#define NTUPLE_LEN 6
+#define NTUPLE_SIZE (1u << (NTUPLE_LEN * CELL_BITS))
+
+// Number of the rotations and reflections of the game board, each of which
+// places the tuples over a different set of cells sharing the same weights.
+#define NTUPLE_SYMS 8
+
+// Identifier of the weights file, spelling "2048NTUP" in little-endian
+// byte order, and the version of its format.
+#define WEIGHTS_MAGIC 0x5055544E38343032ULL
+#define WEIGHTS_VERSION 2
+
+// Alignment of the weights within the weights file in bytes, matching the
+// size of the huge pages such that the weights can be mapped with them.
+#define WEIGHTS_ALIGN (1u << 21)
+
+// Learning rate of the training, spread evenly across the weights updated
+// for each game board, and the number of games per reported batch.
+#define TRAIN_RATE 0.1f
+#define TRAIN_BATCH 1000
+
 #define COLOR_SELECT 1
 
+// Key for requesting a hint for the next move on the game board.
+#define KEY_HINT 'h'
+
 #define ASCII_ESC 27
 #define ASCII_LF 10
 
@@ -58,6 +199,8 @@ extern const len_t win_dialog_txt_len;
 extern const char *lost_dialog_txt[];
 extern const len_t lost_dialog_txt_len;
 
+extern const char *dir_names[];
+
 extern const handler_t main_menu_handlers[];
 extern const handler_t pause_menu_handlers[];
 
@@ -0,0 +1,11 @@
+#ifndef _GRID_H
+#define _GRID_H
+
+#include <stdint.h>
+#include "shared.h"
+
+MoveResult move_grid(cell_t *grid, uint8_t size, dir_t dir, cell_t *max_val);
+uint64_t grid_empty_mask(const cell_t *grid, uint8_t size);
+uint8_t grid_legal_moves(const cell_t *grid, uint8_t size);
+
+#endif
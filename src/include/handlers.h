@@ -2,8 +2,12 @@
 #define _CORE_H
 
 #include "shared.h"
+#include "consts.h"
+#include "stats.h"
 
 extern Game game;
+extern FrameStats frame_stats;
+extern LatencyStats *latency_stats;
 
 handler_t handle_main_menu(Dimension *scr_dim);
 handler_t handle_pause_menu(Dimension *scr_dim);
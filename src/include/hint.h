@@ -0,0 +1,14 @@
+#ifndef _HINT_H
+#define _HINT_H
+
+#include <stdbool.h>
+#include "shared.h"
+
+bool start_hints(void);
+void stop_hints(void);
+
+bool request_hint(board_t board);
+void cancel_hint(void);
+bool take_hint(board_t board, SearchResult *result);
+
+#endif
@@ -3,8 +3,14 @@
 
 #include <ncurses.h>
 #include "shared.h"
+#include "stats.h"
 
-void init_game_win(WinContext *wctx, Dimension *scr_dim);
-void show_board(WinContext *wctx, Game *game, Dimension *scr_dim);
+void init_tile_labels(void);
+void init_game_win(WinContext *wctx, Dimension *scr_dim, len_t size);
+void resize_game_win(WinContext *wctx, Dimension *scr_dim);
+void stage_board(WinContext *wctx, Game *game, const SearchResult *hint, Dimension *scr_dim);
+void show_board(WinContext *wctx, Game *game, const SearchResult *hint, Dimension *scr_dim);
+
+void show_stats_overlay(WinContext *wctx, const LatencyStats *stats);
 
 #endif
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <ncurses.h>
 #include "shared.h"
 
-void init_screen();
+bool init_screen(FILE *output);
 void show_end_game_dialog(const char *mesg[], size_t mesg_len, Dimension *scr_dim);
 
 #endif
@@ -5,9 +5,11 @@
 #include "shared.h"
 
 void init_main_menu(WinContext *wctx, Dimension *scr_dim);
+void resize_main_menu(WinContext *wctx, Dimension *scr_dim);
 void show_main_menu(WinContext *wctx, index_t select);
 
 void init_pause_menu(WinContext *wctx, Dimension *scr_dim);
+void resize_pause_menu(WinContext *wctx, Dimension *scr_dim);
 void show_pause_menu(WinContext *wctx, index_t select);
 
 #endif
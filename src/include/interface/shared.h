@@ -4,6 +4,11 @@
 #include <ncurses.h>
 #include "shared.h"
 
-WINDOW *init_window(Dimension *dim);
+WINDOW *init_window(index_t id, Dimension *dim);
+void free_windows(void);
+
+void center_window(WinContext *wctx, Dimension *scr_dim);
+bool read_screen_dim(Dimension *scr_dim, len_t size);
+void debounce_resize(void);
 
 #endif
\ No newline at end of file
@@ -3,18 +3,170 @@
 
 #include <stdbool.h>
 #include "shared.h"
+#include "consts.h"
 
-cell_t **create_board(void);
-void free_board(cell_t **board);
+/**
+ * @brief Extracts the value of the specified cell from the packed game board.
+ * @return Base-2 logarithm of the tile value, or 0 if the cell is empty.
+ */
+static inline cell_t get_cell(board_t board, index_t row, index_t col)
+{
+    return (board >> ((row * BOARD_SIZE + col) * CELL_BITS)) & CELL_MASK;
+}
 
-void setup_game(Game *game);
-bool is_game_over(Game *game, bool cell_empty);
-bool place_random(Game *game);
+/**
+ * @brief Stores the specified value at a cell on the packed game board.
+ * @return The updated game board.
+ */
+static inline board_t set_cell(board_t board, index_t row, index_t col, cell_t val)
+{
+    uint8_t shift = (row * BOARD_SIZE + col) * CELL_BITS;
+    return (board & ~((board_t)CELL_MASK << shift)) | ((board_t)val << shift);
+}
+
+/**
+ * @brief Transposes the packed game board, swapping its rows and columns.
+ *
+ * @details Swaps the cells across the main diagonal in two steps, first
+ * swapping the 4-bit cells within each 2x2 block of cells, and then the
+ * 2x2 blocks across the diagonal, using masks and shifts on the packed
+ * board without unpacking any cells.
+ *
+ * @return The transposed game board.
+ */
+static inline board_t transpose(board_t board)
+{
+    board_t a1 = board & 0xF0F00F0FF0F00F0FULL;
+    board_t a2 = board & 0x0000F0F00000F0F0ULL;
+    board_t a3 = board & 0x0F0F00000F0F0000ULL;
+    board_t a = a1 | (a2 << 12) | (a3 >> 12);
+
+    board_t b1 = a & 0xFF00FF0000FF00FFULL;
+    board_t b2 = a & 0x00FF00FF00000000ULL;
+    board_t b3 = a & 0x00000000FF00FF00ULL;
+
+    return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+/**
+ * @brief Reflects the packed game board horizontally, reversing the
+ * order of the cells within each row.
+ *
+ * @details Swaps the adjacent cells within each byte, and then the
+ * adjacent bytes within each row of the game board.
+ *
+ * @return The reflected game board.
+ */
+static inline board_t flip_rows(board_t board)
+{
+    board = ((board & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((board >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+    return ((board & 0x00FF00FF00FF00FFULL) << 8) | ((board >> 8) & 0x00FF00FF00FF00FFULL);
+}
+
+/**
+ * @brief Reflects the packed game board vertically, reversing the order
+ * of the rows of the game board.
+ *
+ * @details Reverses the bytes of the game board, and swaps the bytes
+ * within each row back to their original order.
+ *
+ * @return The reflected game board.
+ */
+static inline board_t flip_cols(board_t board)
+{
+    board = __builtin_bswap64(board);
+    return ((board & 0x00FF00FF00FF00FFULL) << 8) | ((board >> 8) & 0x00FF00FF00FF00FFULL);
+}
+
+/**
+ * @brief Computes the canonical form of the packed game board.
+ *
+ * @details The 8 rotations and reflections of the game board are obtained
+ * by combining the transposition with the horizontal and the vertical
+ * reflections, and the smallest among them is selected, such that all the
+ * symmetric game boards share the same canonical form.
+ *
+ * @return The canonical form of the game board.
+ */
+static inline board_t canonical_board(board_t board)
+{
+    board_t syms[8];
+
+    syms[0] = board;
+    syms[1] = transpose(board);
+
+    for (index_t i = 0; i < 2; ++i)
+    {
+        syms[i + 2] = flip_rows(syms[i]);
+        syms[i + 4] = flip_cols(syms[i]);
+        syms[i + 6] = flip_cols(syms[i + 2]);
+    }
+
+    board_t min = board;
 
-bool add_horizontal(Game *game, bool to_left);
-bool add_vertical(Game *game, bool to_top);
+    for (index_t i = 1; i < 8; ++i)
+        min = syms[i] < min ? syms[i] : min;
+
+    return min;
+}
+
+/**
+ * @brief Computes the mask of the empty cells on the packed game board.
+ *
+ * @details Folds the bits of each cell into its lowest bit, and gathers
+ * the lowest bits of all the cells into a contiguous 16-bit mask, with
+ * the first cell of the board at the least significant bit.
+ *
+ * @return Mask with the bits set for the empty cells.
+ */
+static inline uint16_t empty_mask(board_t board)
+{
+    board |= board >> 2;
+    board |= board >> 1;
+    board = ~board & 0x1111111111111111ULL;
+
+    // Gathers the bits spaced 4 bits apart by halving the gaps between
+    // the adjacent groups of bits at each step.
+    board = (board | (board >> 3)) & 0x0303030303030303ULL;
+    board = (board | (board >> 6)) & 0x000F000F000F000FULL;
+    board = (board | (board >> 12)) & 0x000000FF000000FFULL;
+
+    return board | (board >> 24);
+}
+
+/**
+ * @brief Checks whether the game board of the Game struct is
+ * stored in the packed representation.
+ */
+static inline bool is_packed(const Game *game)
+{
+    return !game->size || game->size == BOARD_SIZE;
+}
+
+/**
+ * @brief Extracts the value of the specified cell from the game
+ * board of the Game struct irrespective of its representation.
+ *
+ * @return Base-2 logarithm of the tile value, or 0 if the cell is empty.
+ */
+static inline cell_t get_tile(const Game *game, index_t row, index_t col)
+{
+    if (!is_packed(game))
+        return game->grid[row * game->size + col];
+
+    return get_cell(game->board, row, col);
+}
+
+void init_move_tables(void);
+
+void setup_game(Game *game);
+bool is_game_over(Game *game);
+len_t place_random(Game *game);
+uint8_t legal_moves(board_t board);
 
-bool move_horizontal(Game *game, bool to_left);
-bool move_vertical(Game *game, bool to_top);
+MoveResult move_horizontal(Game *game, bool to_left);
+MoveResult move_vertical(Game *game, bool to_top);
+MoveResult move_board(Game *game, dir_t dir);
+board_t shift_board(board_t board, dir_t dir);
 
 #endif
@@ -0,0 +1,44 @@
+#ifndef _NTUPLE_H
+#define _NTUPLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "shared.h"
+#include "consts.h"
+
+// Stores the header of the weights file, identifying the format along with
+// the tuples the weights were trained for, and the offset and the size in
+// bytes of the weights of all the tuples stored in the order of the tuples.
+// The weights are stored in the native layout of the floats at an offset
+// aligned to WEIGHTS_ALIGN, such that they are mapped without any parsing.
+typedef struct
+{
+    uint64_t magic;
+    uint32_t version;
+    uint8_t cnt;
+    uint8_t len;
+    uint8_t tuples[NTUPLE_CNT][NTUPLE_LEN];
+    uint64_t offset;
+    uint64_t size;
+} WeightsHeader;
+
+// Stores the weights of the n-tuple network, comprising a table of
+// NTUPLE_SIZE weights for each tuple indexed by the cells it covers,
+// which are either allocated or mapped from the weights file.
+typedef struct
+{
+    float *weights;
+    bool mapped;
+} Network;
+
+bool init_network(Network *net);
+void free_network(Network *net);
+
+bool load_network(Network *net, const Options *opts, bool writable);
+bool save_network(const Network *net, const char *path);
+
+float evaluate_network(const Network *net, board_t board);
+void update_network(Network *net, board_t board, float delta);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef _OPTIONS_H
+#define _OPTIONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "shared.h"
+
+bool parse_count(const char *arg, uint32_t *value);
+bool parse_options(int argc, char *argv[], Options *opts);
+
+#endif
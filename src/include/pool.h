@@ -0,0 +1,55 @@
+#ifndef _POOL_H
+#define _POOL_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "shared.h"
+#include "consts.h"
+
+// Performs the task at the specified index on behalf of the specified worker.
+typedef void (*task_t)(void *ctx, uint8_t worker, uint32_t index);
+
+typedef struct Pool Pool;
+
+// Stores the range of the task indices yet to be claimed from a worker,
+// with the lower and the upper bound packed into the lower and the upper
+// half of the word, such that either end is claimed with a single CAS.
+typedef struct
+{
+    _Alignas(CACHE_LINE) uint64_t range;
+} WorkQueue;
+
+typedef struct
+{
+    pthread_t thread;
+    Pool *pool;
+    uint8_t id;
+} Worker;
+
+// Stores the worker threads along with the batch of tasks being performed,
+// where the calling thread of each batch participates as the first worker.
+struct Pool
+{
+    Worker *workers;
+    WorkQueue *queues;
+    uint8_t cnt;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+
+    uint64_t batch;
+    uint8_t active;
+    bool stop;
+
+    task_t task;
+    void *ctx;
+};
+
+bool init_pool(Pool *pool, uint8_t cnt);
+void free_pool(Pool *pool);
+void run_pool(Pool *pool, task_t task, void *ctx, uint32_t len);
+
+#endif
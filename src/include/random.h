@@ -0,0 +1,59 @@
+#ifndef _RANDOM_H
+#define _RANDOM_H
+
+#include <stdint.h>
+#include "shared.h"
+
+void seed_rng(Rng *rng, uint64_t seed);
+
+/**
+ * @brief Generates the next 64-bit value from the xoshiro256** sequence.
+ * @param rng Pointer to the Rng struct comprising the generator state.
+ */
+static inline uint64_t next_random(Rng *rng)
+{
+    uint64_t *s = rng->state;
+    uint64_t result = s[1] * 5;
+
+    result = ((result << 7) | (result >> 57)) * 9;
+
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return result;
+}
+
+/**
+ * @brief Generates an unbiased random value within the range [0, bound).
+ *
+ * @details Maps the upper 32 bits of a random value onto the range by
+ * multiplication instead of modulo, and only rejects the values which
+ * would otherwise introduce a bias, requiring a division only on the
+ * rarely taken rejection path.
+ *
+ * @param rng Pointer to the Rng struct comprising the generator state.
+ * @param bound Exclusive upper bound of the range, which must be non-zero.
+ */
+static inline uint32_t random_range(Rng *rng, uint32_t bound)
+{
+    uint64_t product = (next_random(rng) >> 32) * bound;
+
+    if ((uint32_t)product < bound)
+    {
+        uint32_t threshold = -bound % bound;
+
+        while ((uint32_t)product < threshold)
+            product = (next_random(rng) >> 32) * bound;
+    }
+
+    return product >> 32;
+}
+
+#endif
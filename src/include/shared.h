@@ -7,23 +7,118 @@
 
 #include <ncurses.h>
 
-typedef uint16_t cell_t;
+typedef uint8_t cell_t;
 typedef uint16_t input_t;
 typedef uint8_t select_t;
-typedef uint32_t score_t;
+typedef uint64_t score_t;
 typedef int8_t index_t;
 typedef uint16_t pos_t;
 typedef uint16_t len_t;
 typedef uint8_t handler_t;
+typedef uint8_t dir_t;
 
+// The game board of the default size is packed into a single 64-bit word,
+// where each cell occupies 4 bits holding the base-2 logarithm of its tile
+// value, with 0 signifying an empty cell. Cells are stored in row-major
+// order starting from the least significant bits of the word.
+typedef uint64_t board_t;
+typedef uint16_t row_t;
+
+// Stores the state of the xoshiro256** pseudo random number generator.
+typedef struct
+{
+    uint64_t state[4];
+} Rng;
+
+// Game boards of the other sizes are stored in the 'grid' array in
+// row-major order, holding the same values as the packed game board. Both
+// share the same storage sized for the largest supported size, i.e. 8x8,
+// such that the struct holds the complete game state and can be copied by
+// value. A size of 0 signifies the default size.
+//
+// The number of empty cells is kept up to date across the moves and the
+// placements, and the mask of the legal directions is refreshed after each
+// placement, indexed by the DIR_* constants.
 typedef struct
 {
-    cell_t **board;
+    union
+    {
+        board_t board;
+        cell_t grid[64];
+    };
+
+    uint8_t size;
     cell_t max_val;
     score_t score;
+    uint8_t empty;
+    uint8_t legal;
     bool init;
+    Rng rng;
 } Game;
 
+// Stores the precomputed transition of an individual row of the game board
+// for a specific direction. The score is narrower than the score_t type, as
+// a row of 4-bit cells gains at most 2^16 points, halving the size of the
+// transition tables.
+typedef struct
+{
+    row_t row;
+    cell_t max_val;
+    uint8_t merges;
+    uint32_t score;
+} RowMove;
+
+// Stores the same transition as the RowMove struct for an individual column
+// of the game board, with the resultant column laid out in its place on the
+// game board, such that a vertical move requires a single lookup per column.
+typedef struct
+{
+    board_t col;
+    uint32_t score;
+    uint8_t merges;
+    cell_t max_val;
+} ColMove;
+
+// Stores the result of an individual move on the game board.
+typedef struct
+{
+    score_t score;
+    uint8_t merges;
+    bool changed;
+} MoveResult;
+
+// Stores the result of a search for the best move on the game board,
+// where the value is the expected heuristic value of the move, and the
+// depth is the number of successive moves the move was searched with.
+typedef struct
+{
+    dir_t dir;
+    bool found;
+    float value;
+    uint64_t nodes;
+    uint8_t depth;
+} SearchResult;
+
+// Stores the command-line options specified for the program execution.
+typedef struct
+{
+    uint32_t simulate;
+    uint32_t soak;
+    uint32_t train;
+    const char *policy;
+    const char *stats;
+    const char *weights;
+    uint64_t seed;
+    bool seeded;
+    uint8_t size;
+    uint8_t depth;
+    uint8_t threads;
+    uint32_t table;
+    uint32_t budget;
+    bool huge_pages;
+    bool verbose;
+} Options;
+
 typedef struct
 {
     len_t height;
@@ -0,0 +1,9 @@
+#ifndef _SIMULATE_H
+#define _SIMULATE_H
+
+#include <stdbool.h>
+#include "shared.h"
+
+bool run_simulation(Options *opts);
+
+#endif
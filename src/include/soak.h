@@ -0,0 +1,8 @@
+#ifndef _SOAK_H
+#define _SOAK_H
+
+#include "shared.h"
+
+void run_soak(Options *opts);
+
+#endif
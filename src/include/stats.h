@@ -0,0 +1,46 @@
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "shared.h"
+#include "consts.h"
+
+// Stores the statistics of the frames displayed on the game board, where
+// the moves performed back to back for a burst of keys share a frame.
+typedef struct
+{
+    uint64_t frames;
+    uint64_t moves;
+    len_t max_batch;
+    uint32_t batches[MAX_BATCH + 1];
+} FrameStats;
+
+// Stores the distribution of durations in nanoseconds within log-linear
+// buckets, each power of 2 being divided into equally sized sub-buckets.
+typedef struct
+{
+    uint32_t buckets[HIST_BUCKETS];
+    uint64_t count;
+    uint64_t max;
+} Histogram;
+
+// Stores the latency histograms of the individual stages of the frames
+// displayed on the game board, along with the overall input latency.
+typedef struct
+{
+    Histogram logic;
+    Histogram render;
+    Histogram flush;
+    Histogram total;
+} LatencyStats;
+
+uint64_t clock_ns(void);
+
+void record_sample(Histogram *hist, uint64_t ns);
+uint64_t hist_percentile(const Histogram *hist, uint8_t percentile);
+
+bool dump_stats(const char *path, const LatencyStats *stats, const FrameStats *frames);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _TABLE_H
+#define _TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "shared.h"
+#include "consts.h"
+
+// Stores the searched value of a canonical game board in the lower half of
+// the data, along with the remaining depth it was searched with above it.
+// The key is stored XORed with the data, such that an entry torn by the
+// concurrent writes of multiple threads fails to match its key instead of
+// yielding a mismatched value. A key of 0 signifies an unused entry, as
+// the empty game board never occurs during the search.
+typedef struct
+{
+    uint64_t check;
+    uint64_t data;
+} TableEntry;
+
+// Stores the entries sharing the same index within a single cache line.
+typedef struct
+{
+    _Alignas(CACHE_LINE) TableEntry entries[TABLE_WAYS];
+} TableBucket;
+
+// Stores the transposition table for the search along with the number
+// of lookups which found a usable entry and the number which did not,
+// which are accumulated by the searches once they are complete.
+typedef struct
+{
+    TableBucket *buckets;
+    uint64_t mask;
+    uint64_t hits;
+    uint64_t misses;
+} TransTable;
+
+bool init_table(TransTable *table, size_t budget);
+void free_table(TransTable *table);
+
+bool probe_table(TransTable *table, board_t key, uint8_t depth, float *value);
+void store_table(TransTable *table, board_t key, uint8_t depth, float value);
+
+#endif
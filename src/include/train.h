@@ -0,0 +1,9 @@
+#ifndef _TRAIN_H
+#define _TRAIN_H
+
+#include <stdbool.h>
+#include "shared.h"
+
+bool run_training(Options *opts);
+
+#endif
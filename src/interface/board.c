@@ -5,40 +5,64 @@
  * displaying the game board on the TUI screen.
  */
 
-#include <math.h>
 #include <ncurses.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "shared.h"
 #include "consts.h"
+#include "logic.h"
+#include "stats.h"
 
 #include "interface/shared.h"
 
+// Stores the contents of the game board window and the score as they were
+// last drawn, such that only the changed cells are drawn on the next frame.
+typedef struct
+{
+    cell_t cells[MAX_BOARD_SIZE * MAX_BOARD_SIZE];
+    score_t score;
+    bool score_shown;
+    SearchResult hint;
+    bool hint_shown;
+} BoardCache;
+
+static BoardCache drawn;
+
+// Stores the labels of the tiles indexed by their base-2 logarithms, each
+// padded with spaces to the width of a cell with the value centered, where
+// the label of the empty cell comprises only spaces.
+static char tile_labels[MAX_TILE + 1][CELL_WIDTH + 1];
+
 /**
  * @brief Draws the vertical grid lines.
+ *
  * @param win Pointer to the game board window.
+ * @param size Number of rows and columns in the game board.
  */
-static void draw_vlines(WINDOW *win)
+static void draw_vlines(WINDOW *win, len_t size)
 {
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-        for (pos_t j = 1; j < BOARD_SIZE * (CELL_HEIGHT + 1); ++j)
+    for (index_t i = 0; i < size; ++i)
+        for (pos_t j = 1; j < size * (CELL_HEIGHT + 1); ++j)
             mvwaddch(win, j, i * (CELL_WIDTH + 1), ACS_VLINE);
 }
 
 /**
  * @brief Draws the horizontal grid line for an individual row.
+ *
  * @param win Pointer to the game board window.
+ * @param size Number of rows and columns in the game board.
  */
-static void draw_hline(WINDOW *win)
+static void draw_hline(WINDOW *win, len_t size)
 {
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    for (index_t i = 0; i < size; ++i)
     {
         for (index_t _ = 0; _ < CELL_WIDTH; ++_)
             waddch(win, ACS_HLINE);
 
         // Draws a '+' symbol at the intersection of the vertical
         // and horizontal grid lines for visual appeal.
-        if (i != BOARD_SIZE - 1)
+        if (i != size - 1)
             waddch(win, ACS_PLUS);
     }
 }
@@ -50,19 +74,20 @@ static void draw_hline(WINDOW *win)
  * the edges of the horizontal and vertical grid lines on the game board.
  *
  * @param win Pointer to the game board window.
+ * @param size Number of rows and columns in the game board.
  */
-static void draw_edges(WINDOW *win)
+static void draw_edges(WINDOW *win, len_t size)
 {
     // Draws the edges for individual horizontal and vertical lines.
-    for (index_t i = 1; i < BOARD_SIZE; ++i)
+    for (index_t i = 1; i < size; ++i)
     {
         // Draws the edges for the vertical grid line.
         mvwaddch(win, 0, (CELL_WIDTH + 1) * i, ACS_TTEE);
-        mvwaddch(win, BOARD_HEIGHT - 1, (CELL_WIDTH + 1) * i, ACS_BTEE);
+        mvwaddch(win, BOARD_HEIGHT(size) - 1, (CELL_WIDTH + 1) * i, ACS_BTEE);
 
         // Draws the edges for the horizontal grid line.
         mvwaddch(win, (CELL_HEIGHT + 1) * i, 0, ACS_LTEE);
-        mvwaddch(win, (CELL_HEIGHT + 1) * i, BOARD_WIDTH - 1, ACS_RTEE);
+        mvwaddch(win, (CELL_HEIGHT + 1) * i, BOARD_WIDTH(size) - 1, ACS_RTEE);
     }
 }
 
@@ -70,69 +95,68 @@ static void draw_edges(WINDOW *win)
  * @brief Draws the game board grid layout.
  *
  * @param win Pointer to the game board window.
- * @param bsize Size of the game board.
+ * @param size Number of rows and columns in the game board.
  */
-static void draw_grid(WINDOW *win)
+static void draw_grid(WINDOW *win, len_t size)
 {
     box(win, 0, 0);
 
-    draw_edges(win);
-    draw_vlines(win);
+    draw_edges(win, size);
+    draw_vlines(win, size);
 
     // Draws individual horizontal grid lines for each row of cells.
-    for (index_t i = 1; i < BOARD_SIZE; ++i)
+    for (index_t i = 1; i < size; ++i)
     {
         wmove(win, i * (CELL_HEIGHT + 1), 1);
-        draw_hline(win);
+        draw_hline(win, size);
     }
 
-    wrefresh(win);
+    wnoutrefresh(win);
 }
 
 /**
  * @brief Populate the cells with their corresponding values on the game board.
  *
+ * @details Only the cells whose values differ from the values last drawn
+ * are drawn again, and the window is only staged for the next update if
+ * any cell changed.
+ *
  * @param win Pointer to the game board window.
  * @param game Pointer to the Game struct comprising the game data.
  */
 static void populate_cells(WINDOW *win, Game *game)
 {
-    pos_t pos_x, pos_y;
-    len_t num_len;
+    cell_t cell;
+    bool changed = false;
 
     wattron(win, A_BOLD);
 
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    for (index_t i = 0; i < game->size; ++i)
     {
-        for (index_t j = 0; j < BOARD_SIZE; ++j)
+        for (index_t j = 0; j < game->size; ++j)
         {
-            // Calculates the X and Y coordinates for value placement.
-            pos_x = j * (CELL_WIDTH + 1) + 1;
-            pos_y = i * (CELL_HEIGHT + 1) + CELL_HEIGHT / 2 + 1;
-
-            // Clears the middle row of the cell to remove any
-            // previously placed value.
-            wmove(win, pos_y, pos_x);
-            wprintw(win, "%*s", CELL_WIDTH, "");
-
-            if (!game->board[i][j])
+            if ((cell = get_tile(game, i, j)) == drawn.cells[i * game->size + j])
                 continue;
 
-            // Calculates the length of the number to place it
-            // in the center of the cell.
-            num_len = floor(log10(game->board[i][j])) + 1;
+            drawn.cells[i * game->size + j] = cell;
+            changed = true;
 
-            wmove(win, pos_y, pos_x + (CELL_WIDTH - num_len) / 2);
-            wprintw(win, "%d", game->board[i][j]);
+            // Overwrites the middle row of the cell with the label, which
+            // also removes any previously placed value.
+            mvwaddnstr(win, i * (CELL_HEIGHT + 1) + CELL_HEIGHT / 2 + 1,
+                       j * (CELL_WIDTH + 1) + 1, tile_labels[cell], CELL_WIDTH);
         }
     }
 
     wattroff(win, A_BOLD);
-    wrefresh(win);
+
+    if (changed)
+        wnoutrefresh(win);
 }
 
 /**
- * @brief Displays the game score at the bottom of the screen.
+ * @brief Displays the game score at the bottom of the screen
+ * if it differs from the score last displayed.
  *
  * @param score The score to be displayed.
  * @param scr_dim Pointer to the Dimension struct comprising the
@@ -140,49 +164,200 @@ static void populate_cells(WINDOW *win, Game *game)
  */
 static void show_game_score(score_t score, Dimension *scr_dim)
 {
-    char string[20];
-    snprintf(string, sizeof(string), "Score: %u", score);
+    if (drawn.score_shown && score == drawn.score)
+        return;
+
+    drawn.score = score;
+    drawn.score_shown = true;
+
+    char string[32];
+    snprintf(string, sizeof(string), "Score: %llu", (unsigned long long)score);
+
+    // Clears the line to remove any previously displayed longer score.
+    move(scr_dim->height - 2, 0);
+    clrtoeol();
 
     move(scr_dim->height - 2, (scr_dim->width - strlen(string)) / 2);
     printw("%s", string);
 
-    refresh();
+    wnoutrefresh(stdscr);
+}
+
+/**
+ * @brief Displays the hint for the next move below the game window.
+ *
+ * @details The line of the hint is only redrawn if the hint differs from
+ * the one last drawn, and is cleared if no hint is to be displayed.
+ *
+ * @param hint Pointer to the SearchResult struct comprising the
+ * recommended move, or NULL to clear the hint.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+static void show_hint(const SearchResult *hint, Dimension *scr_dim)
+{
+    bool shown = hint && hint->found;
+
+    if (shown == drawn.hint_shown &&
+        (!shown || (hint->dir == drawn.hint.dir && hint->depth == drawn.hint.depth)))
+        return;
+
+    drawn.hint_shown = shown;
+
+    move(scr_dim->height - 3, 0);
+    clrtoeol();
+
+    if (shown)
+    {
+        char string[40];
+        snprintf(string, sizeof(string), "Hint: %s (depth %u)", dir_names[hint->dir], hint->depth);
+
+        mvprintw(scr_dim->height - 3, (scr_dim->width - strlen(string)) / 2, "%s", string);
+        drawn.hint = *hint;
+    }
+
+    wnoutrefresh(stdscr);
+}
+
+/**
+ * @brief Precomputes the centered labels for all the tile values.
+ *
+ * @details Tile values whose digits do not fit within the width of a
+ * cell are labelled with their exponent instead, e.g. 2^27.
+ */
+void init_tile_labels(void)
+{
+    char num[24];
+    int num_len;
+
+    memset(tile_labels[0], ' ', CELL_WIDTH);
+
+    for (cell_t i = 1; i <= MAX_TILE; ++i)
+    {
+        num_len = i < 64 ? snprintf(num, sizeof(num), "%llu", 1ULL << i) : CELL_WIDTH + 1;
+
+        if (num_len > CELL_WIDTH)
+            num_len = snprintf(num, sizeof(num), "2^%u", i);
+
+        // Places the number in the center of the cell, leaving
+        // the extra space on the right for odd paddings.
+        memset(tile_labels[i], ' ', CELL_WIDTH);
+        memcpy(tile_labels[i] + (CELL_WIDTH - num_len) / 2, num, num_len);
+    }
 }
 
 /**
  * @brief Initializes the game window and displays its
  * static layout on the TUI screen.
  *
+ * @details As the new window is blank, the cells last drawn are reset
+ * to empty cells, such that the tiles are drawn on the next frame.
+ *
  * @param wctx Pointer to the WinContxet struct comprising the window data.
  * @param scr_dim Pointer to the Dimension struct comprising the
  * screen dimensions.
+ * @param size Number of rows and columns in the game board.
  */
-void init_game_win(WinContext *wctx, Dimension *scr_dim)
+void init_game_win(WinContext *wctx, Dimension *scr_dim, len_t size)
 {
     Dimension *dim = wctx->dimension;
 
     *dim = (Dimension){
-        BOARD_HEIGHT,
-        BOARD_WIDTH,
-        (scr_dim->height - BOARD_HEIGHT) / 2,
-        (scr_dim->width - BOARD_WIDTH) / 2,
+        BOARD_HEIGHT(size),
+        BOARD_WIDTH(size),
+        (scr_dim->height - BOARD_HEIGHT(size)) / 2,
+        (scr_dim->width - BOARD_WIDTH(size)) / 2,
     };
 
-    wctx->window = init_window(dim);
-    draw_grid(wctx->window);
+    wctx->window = init_window(WIN_GAME_BOARD, dim);
+    draw_grid(wctx->window, size);
+
+    drawn = (BoardCache){0};
 }
 
 /**
- * @brief Displays the game window on the TUI screen.
+ * @brief Relayouts the game window on the resized TUI screen.
+ *
+ * @details Moves the game window along with the grid and the cells drawn
+ * within it to the center of the screen without redrawing them, and marks
+ * the score and the hint to be displayed again at their new positions on
+ * the next frame.
+ *
+ * @param wctx Pointer to the WinContext struct comprising the window data.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+void resize_game_win(WinContext *wctx, Dimension *scr_dim)
+{
+    erase();
+    wnoutrefresh(stdscr);
+
+    center_window(wctx, scr_dim);
+    wnoutrefresh(wctx->window);
+
+    drawn.score_shown = drawn.hint_shown = false;
+}
+
+/**
+ * @brief Stages the game window for the next update of the TUI screen.
  *
  * @details Refreshes the dynamic content of the game window by
- * updating the board cells and displaying the current game score.
+ * updating the board cells and displaying the current game score
+ * along with the hint, without committing the frame to the terminal.
  *
  * @param wctx Pointer to the WinContext struct comprising window data.
  * @param game Pointer to the Game struct comrising the game data.
+ * @param hint Pointer to the SearchResult struct comprising the hint
+ * for the next move, or NULL if no hint is to be displayed.
  */
-void show_board(WinContext *wctx, Game *game, Dimension *scr_dim)
+void stage_board(WinContext *wctx, Game *game, const SearchResult *hint, Dimension *scr_dim)
 {
     populate_cells(wctx->window, game);
     show_game_score(game->score, scr_dim);
+    show_hint(hint, scr_dim);
+}
+
+/**
+ * @brief Displays the game window on the TUI screen.
+ *
+ * @details Stages the game window, and commits all the windows staged
+ * for the frame in a single update of the terminal.
+ *
+ * @param wctx Pointer to the WinContext struct comprising window data.
+ * @param game Pointer to the Game struct comrising the game data.
+ * @param hint Pointer to the SearchResult struct comprising the hint
+ * for the next move, or NULL if no hint is to be displayed.
+ */
+void show_board(WinContext *wctx, Game *game, const SearchResult *hint, Dimension *scr_dim)
+{
+    stage_board(wctx, game, hint, scr_dim);
+    doupdate();
+}
+
+/**
+ * @brief Stages the latency statistics overlay at the top of the screen.
+ *
+ * @details Displays the median, 99th percentile and maximum latencies in
+ * microseconds for each stage of the frames recorded so far. The overlay
+ * is omitted if it would overlap the game window.
+ *
+ * @param wctx Pointer to the WinContext struct comprising window data.
+ * @param stats Pointer to the LatencyStats struct comprising the latencies.
+ */
+void show_stats_overlay(WinContext *wctx, const LatencyStats *stats)
+{
+    const char *names[] = {"logic", "render", "flush", "total"};
+    const Histogram *hists[] = {&stats->logic, &stats->render, &stats->flush, &stats->total};
+
+    if (wctx->dimension->start_y < STATS_ROWS)
+        return;
+
+    for (index_t i = 0; i < STATS_ROWS; ++i)
+    {
+        mvprintw(i, 0, "%-7s p50 %9.1f  p99 %9.1f  max %9.1f us", names[i],
+                 hist_percentile(hists[i], 50) / 1e3,
+                 hist_percentile(hists[i], 99) / 1e3, hists[i]->max / 1e3);
+    }
+
+    wnoutrefresh(stdscr);
 }
@@ -16,10 +16,20 @@
 
 /**
  * @brief Initializes and configures the standard TUI screen.
+ *
+ * @param output Stream on which the screen is to be displayed in place of
+ * the terminal, or NULL for displaying the screen on the terminal.
+ *
+ * @return Boolean value indicating whether the screen was initialized.
  */
-void init_screen()
+bool init_screen(FILE *output)
 {
-    initscr();
+    // The screen created by newterm also becomes the current screen.
+    if (!output)
+        initscr();
+
+    else if (!newterm(NULL, output, stdin))
+        return false;
 
     cbreak();
     noecho();
@@ -30,6 +40,15 @@ void init_screen()
 
     curs_set(0);
     keypad(stdscr, TRUE);
+
+    // Until the screen is restored after being suspended once, ncurses
+    // flushes the output after each cursor movement, splitting each frame
+    // into numerous writes. Suspending and restoring the screen before
+    // anything is displayed lets each update be written at once.
+    endwin();
+    refresh();
+
+    return true;
 }
 
 /**
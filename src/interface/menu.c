@@ -40,7 +40,7 @@ static void show_header_footer(Dimension *scr_dim)
         printw("%s", footers[i]);
     }
 
-    refresh();
+    wnoutrefresh(stdscr);
 }
 
 /**
@@ -77,7 +77,7 @@ void init_main_menu(WinContext *wctx, Dimension *scr_dim)
     dim->start_y = (scr_dim->height - dim->height) / 2;
     dim->start_x = (scr_dim->width - dim->width) / 2;
 
-    wctx->window = init_window(dim);
+    wctx->window = init_window(WIN_MAIN_MENU, dim);
 
     box(wctx->window, 0, 0);
     show_menu_heading(main_menu_title, dim->start_y, scr_dim);
@@ -102,13 +102,51 @@ void init_pause_menu(WinContext *wctx, Dimension *scr_dim)
     dim->start_y = (scr_dim->height - dim->height) / 2;
     dim->start_x = (scr_dim->width - dim->width) / 2;
 
-    wctx->window = init_window(dim);
+    wctx->window = init_window(WIN_PAUSE_MENU, dim);
 
     box(wctx->window, 0, 0);
     show_menu_heading(pause_menu_title, dim->start_y, scr_dim);
     show_header_footer(scr_dim);
 }
 
+/**
+ * @brief Relayouts the main menu on the resized TUI screen.
+ *
+ * @details Moves the menu window along with its contents to the center of
+ * the screen, and only redraws the text on the standard screen around it.
+ *
+ * @param wctx Pointer to the WinContext struct comprising the window data.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+void resize_main_menu(WinContext *wctx, Dimension *scr_dim)
+{
+    erase();
+    center_window(wctx, scr_dim);
+
+    show_menu_heading(main_menu_title, wctx->dimension->start_y, scr_dim);
+    show_header_footer(scr_dim);
+}
+
+/**
+ * @brief Relayouts the pause menu on the resized TUI screen.
+ *
+ * @details Moves the menu window along with its contents to the center of
+ * the screen, and only redraws the text on the standard screen around it.
+ *
+ * @param wctx Pointer to the WinContext struct comprising the window data.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+void resize_pause_menu(WinContext *wctx, Dimension *scr_dim)
+{
+    erase();
+    center_window(wctx, scr_dim);
+
+    show_menu_heading(pause_menu_title, wctx->dimension->start_y, scr_dim);
+    show_header_footer(scr_dim);
+}
+
 /**
  * @brief Displays the main menu window on the TUI screen.
  *
@@ -150,7 +188,9 @@ void show_main_menu(WinContext *wctx, index_t select)
             wattroff(win, COLOR_PAIR(COLOR_SELECT));
     }
 
-    wrefresh(win);
+    // Commits the frame staged since the previous update at once.
+    wnoutrefresh(win);
+    doupdate();
 }
 
 /**
@@ -194,5 +234,7 @@ void show_pause_menu(WinContext *wctx, index_t select)
             wattroff(win, COLOR_PAIR(COLOR_SELECT));
     }
 
-    wrefresh(win);
+    // Commits the frame staged since the previous update at once.
+    wnoutrefresh(win);
+    doupdate();
 }
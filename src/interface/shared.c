@@ -7,23 +7,151 @@
  */
 
 #include <ncurses.h>
+
 #include "shared.h"
+#include "consts.h"
+
+// Stores the windows indexed by their identifiers. Each window is created
+// the first time its screen is displayed, and is reused for the subsequent
+// displays of the screen until the TUI environment is closed.
+static WINDOW *windows[WIN_CNT];
+
+// Stores the pad from which the input is read while the resize events are
+// being debounced. Unlike the other windows, reading input from a pad does
+// not refresh it, and hence does not display any intermediate frames.
+static WINDOW *input_pad;
 
 /**
- * @brief Initializes and configures a new ncurses TUI window.
+ * @brief Initializes and configures the TUI window with the specified
+ * identifier, creating the window only if it does not already exist.
+ *
+ * @details An existing window is cleared, and is resized and moved in
+ * place to the specified dimensions, instead of creating a new window.
+ *
+ * @param id Index of the window within the window registry.
  * @param dim Pointer to the Dimension struct comprising the window dimensions.
- * @return Pointer to the newly created window.
+ *
+ * @return Pointer to the window.
  */
-WINDOW *init_window(Dimension *dim)
+WINDOW *init_window(index_t id, Dimension *dim)
 {
-    WINDOW *win = newwin(
-        dim->height,
-        dim->width,
-        dim->start_y,
-        dim->start_x);
+    WINDOW *win = windows[id];
 
-    refresh();
-    keypad(win, TRUE);
+    if (!win)
+    {
+        win = windows[id] = newwin(
+            dim->height,
+            dim->width,
+            dim->start_y,
+            dim->start_x);
+
+        keypad(win, TRUE);
+    }
+
+    else
+    {
+        werase(win);
+
+        // The window is resized before being moved, as it cannot be moved
+        // to a position where its previous size would exceed the screen.
+        wresize(win, dim->height, dim->width);
+        mvwin(win, dim->start_y, dim->start_x);
+    }
+
+    // Stages the standard screen, which is cleared before each screen is
+    // displayed, ahead of the window such that the standard screen is not
+    // drawn over the window when the frame is committed.
+    wnoutrefresh(stdscr);
 
     return win;
 }
+
+/**
+ * @brief Moves the window to the center of the screen.
+ *
+ * @details Updates the starting position of the window based on the screen
+ * dimensions and moves the window along with its contents in place, which
+ * are displayed at the new position once the window is staged.
+ *
+ * @param wctx Pointer to the WinContext struct comprising the window data.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+void center_window(WinContext *wctx, Dimension *scr_dim)
+{
+    Dimension *dim = wctx->dimension;
+
+    dim->start_y = (scr_dim->height - dim->height) / 2;
+    dim->start_x = (scr_dim->width - dim->width) / 2;
+
+    mvwin(wctx->window, dim->start_y, dim->start_x);
+    touchwin(wctx->window);
+}
+
+/**
+ * @brief Reads the current screen dimensions.
+ *
+ * @param scr_dim Pointer to the Dimension struct to store the
+ * screen dimensions.
+ * @param size Number of rows and columns in the game board.
+ *
+ * @return Boolean value indicating whether the screen dimensions
+ * are large enough for displaying the in-game screens.
+ */
+bool read_screen_dim(Dimension *scr_dim, len_t size)
+{
+    *scr_dim = (Dimension){
+        .height = getmaxy(stdscr),
+        .width = getmaxx(stdscr),
+    };
+
+    return scr_dim->height >= MIN_HEIGHT && scr_dim->width >= MIN_WIDTH &&
+           scr_dim->height >= BOARD_HEIGHT(size) + BOARD_MARGIN;
+}
+
+/**
+ * @brief Discards the resize events received in quick succession.
+ *
+ * @details Waits for the debounce interval after each resize event for any
+ * further events, such that a burst of resize events, such as while the
+ * terminal is being dragged, results in a single relayout at the final
+ * dimensions. Any other input received within the interval is pushed back
+ * to be read subsequently.
+ */
+void debounce_resize(void)
+{
+    int input;
+
+    if (!input_pad)
+    {
+        input_pad = newpad(1, 1);
+        keypad(input_pad, TRUE);
+        wtimeout(input_pad, RESIZE_DEBOUNCE);
+    }
+
+    while ((input = wgetch(input_pad)) == KEY_RESIZE)
+        ;
+
+    if (input != ERR)
+        ungetch(input);
+}
+
+/**
+ * @brief Deletes all the windows created within the window registry,
+ * along with the pad used for debouncing the resize events.
+ */
+void free_windows(void)
+{
+    for (index_t i = 0; i < WIN_CNT; ++i)
+    {
+        if (windows[i])
+            delwin(windows[i]);
+
+        windows[i] = NULL;
+    }
+
+    if (input_pad)
+        delwin(input_pad);
+
+    input_pad = NULL;
+}
@@ -5,6 +5,11 @@
  * @details This module defines functions for handling the logical
  * components of the game including tile operations and game board
  * management.
+ *
+ * The functions operate on the packed game board, which is loaded into
+ * a local variable at the beginning of each operation and written back
+ * at the end, keeping the board resident in a register throughout. Game
+ * boards of the other sizes are delegated to the kernels in grid.c.
  */
 
 #include <stdlib.h>
@@ -12,354 +17,509 @@
 #include <stdint.h>
 #include <string.h>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 #include "logic.h"
+#include "grid.h"
+#include "random.h"
 #include "shared.h"
 #include "consts.h"
 
-/**
- * @brief Dynamically allocates memory for the game board.
- * @return Pointer to the game board.
- */
-cell_t **create_board(void)
-{
-    cell_t **board = (cell_t **)malloc(BOARD_SIZE * sizeof(cell_t *));
+// Stores the precomputed transitions of every possible row of the game
+// board, where the first and second index signify the transitions for
+// moving the tiles to the left and the right respectively.
+static RowMove row_moves[2][ROW_COUNT];
 
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-        board[i] = (cell_t *)calloc(BOARD_SIZE, sizeof(cell_t));
+// Stores the same transitions for the columns of the game board, indexed
+// by the cells of the column gathered into a row, with the resultant column
+// laid out as the first column of the game board.
+static ColMove col_moves[2][ROW_COUNT];
 
-    return board;
-}
-
-/**
- * @brief Frees the dynamically allocated memory for the game board.
- * @param board Pointer to the game board.
- */
-void free_board(cell_t **board)
-{
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-        free(board[i]);
-
-    free(board);
-}
+// Stores the mask of the directions in which every possible row of the game
+// board can be moved, with the first and second bit signifying the left and
+// the right direction respectively.
+static uint8_t row_legal[ROW_COUNT];
 
 /**
  * @brief Sets up the Game struct for a new game session.
  *
  * @details Resets all the cells on the game board to 0, place 2 random
  * values for the initial state, sets init to true and resets the other
- * variables to their defaults.
+ * variables to their defaults. The state of the random number generator
+ * is retained, which must be seeded beforehand.
  *
  * @param game Pointer to the Game struct comprising the game data.
  */
 void setup_game(Game *game)
 {
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-        memset(game->board[i], 0, BOARD_SIZE * sizeof(cell_t));
+    uint8_t size = is_packed(game) ? BOARD_SIZE : game->size;
+
+    memset(game->grid, 0, sizeof(game->grid));
+    game->empty = size * size;
 
     place_random(game);
     place_random(game);
 
-    game->max_val = 2, game->score = 0;
+    game->max_val = 1, game->score = 0;
     game->init = true;
 }
 
 /**
- * @brief Horizontally adds tiles based on the specified direction.
- *
- * @details Adds and merges adjacent equal tiles horizontally in the
- * specified direction (left/right), and updates the game metadata.
+ * @brief Merges and moves the tiles within a single line of cells.
  *
- * @param game Pointer to the Game struct comprising all the game data.
- * @param to_left Boolean value to indicate whether to perform the
- * operation from right to left or left to right.
+ * @details Performs the complete tile operation on the line in a single
+ * pass, reading each cell once and writing each resultant cell once.
+ * Non-empty cells are compacted towards the start of the line, and each
+ * tile is merged with the preceding tile if both are equal and the
+ * preceding tile has not already been merged. Cells holding the largest
+ * storable value are never merged as the result cannot fit within a cell.
  *
- * @return Boolean value indicating whether any operations were performed.
+ * @param src Array comprising the cells of the line in the order
+ * of the operation.
+ * @param dest Array for storing the resultant cells of the line.
+ * @param entry Pointer to the RowMove struct for storing the score
+ * and the number of merges resulting from the operation.
  */
-bool add_horizontal(Game *game, bool to_left)
+static void slide_line(const cell_t src[BOARD_SIZE], cell_t dest[BOARD_SIZE], RowMove *entry)
 {
-    index_t start, end, last;
-    index_t dir = to_left ? 1 : -1;
+    // Stores the last unmerged tile awaiting a compatible tile,
+    // where 0 signifies the absence of any such tile.
+    cell_t pending = 0;
+    index_t len = 0;
+
+    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    {
+        if (!src[i])
+            continue;
 
-    bool operated = false;
+        else if (src[i] != pending || pending == CELL_MASK)
+        {
+            if (pending)
+                dest[len++] = pending;
 
-    // The following conditional statements define the starting and
-    // ending index for the operation based on the speciifed direction.
+            pending = src[i];
+            continue;
+        }
 
-    if (to_left)
-        start = 0, end = BOARD_SIZE;
+        dest[len++] = ++pending;
 
-    else
-        start = BOARD_SIZE - 1, end = -1;
+        entry->score += 1u << pending;
+        ++entry->merges;
 
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-    {
-        // -1 is used as a special value to signify unavailability
-        // of a compatible cell for operation.
-        last = -1;
+        pending = 0;
+    }
+
+    if (pending)
+        dest[len++] = pending;
 
-        for (index_t j = start; j != end; j += dir)
+    while (len < BOARD_SIZE)
+        dest[len++] = 0;
+}
+
+/**
+ * @brief Initializes the row transition tables.
+ *
+ * @details Precomputes the result of moving every possible row of the
+ * game board towards the left and the right, along with the score gained,
+ * the number of merges and the maximum resultant value, such that moves
+ * on the game board can be performed with a lookup per row. Also records
+ * the directions in which each row can be moved.
+ */
+void init_move_tables(void)
+{
+    cell_t src[BOARD_SIZE], dest[BOARD_SIZE];
+    RowMove *entry;
+
+    for (uint32_t row = 0; row < ROW_COUNT; ++row)
+    {
+        for (index_t dir = 0; dir < 2; ++dir)
         {
-            if (!game->board[i][j])
-                continue;
+            entry = &row_moves[dir][row];
+            *entry = (RowMove){0};
 
-            else if (last == -1 || game->board[i][j] != game->board[i][last])
-            {
-                last = j;
-                continue;
-            }
+            // Unpacks the row with the cells ordered in the direction of
+            // operation, i.e. reversed for moving the tiles to the right.
+            for (index_t i = 0; i < BOARD_SIZE; ++i)
+                src[dir ? BOARD_SIZE - i - 1 : i] = (row >> (i * CELL_BITS)) & CELL_MASK;
 
-            game->board[i][last] *= 2;
-            game->board[i][j] = 0;
+            slide_line(src, dest, entry);
 
-            // Updates the game metadata and operations counter, and
-            // resets the "last" variable to signify unavailability.
+            ColMove *col = &col_moves[dir][row];
+            col->col = 0;
 
-            if (game->board[i][last] > game->max_val)
-                game->max_val = game->board[i][last];
+            for (index_t i = 0; i < BOARD_SIZE; ++i)
+            {
+                cell_t cell = dest[dir ? BOARD_SIZE - i - 1 : i];
 
-            game->score += game->board[i][last];
-            last = -1;
+                entry->row |= cell << (i * CELL_BITS);
+                col->col |= (board_t)cell << (i * ROW_BITS);
 
-            operated = true;
+                if (dest[i] > entry->max_val)
+                    entry->max_val = dest[i];
+            }
+
+            col->score = entry->score;
+            col->merges = entry->merges;
+            col->max_val = entry->max_val;
+
+            if (entry->row != row)
+                row_legal[row] |= 1 << dir;
         }
     }
-
-    return operated;
 }
 
 /**
- * @brief Vertically adds tiles based on the specified direction.
+ * @brief Moves the tiles within each row of the game board.
  *
- * @details Adds and merges adjacent equal tiles vertically in the
- * specified direction (top/down), and updates the game metadata.
- *
- * @param game Pointer to the Game struct comprising the game data.
- * @param to_top Boolean value to indicate whether to perform the
- * operation from bottom to top or from top to bottom.
+ * @param board The packed game board.
+ * @param table Pointer to the transition table for the direction.
+ * @param result Pointer to the MoveResult struct for storing the
+ * score gained and the number of merges.
+ * @param max_val Pointer to store the maximum resultant value.
  *
- * @return Boolean value indicating whether any operations were performed.
+ * @return The resultant game board.
  */
-bool add_vertical(Game *game, bool to_top)
+static inline board_t move_rows(
+    board_t board, const RowMove *table, MoveResult *result, cell_t *max_val)
 {
-    index_t start, end, last;
-    index_t dir = to_top ? 1 : -1;
+    const RowMove *entry;
+    board_t dest = 0;
 
-    bool operated = false;
+    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    {
+        entry = &table[(board >> (i * ROW_BITS)) & ROW_MASK];
+        dest |= (board_t)entry->row << (i * ROW_BITS);
 
-    // The following conditional statements define the starting and
-    // ending index for the operation based on the specified direction.
+        result->score += entry->score;
+        result->merges += entry->merges;
 
-    if (to_top)
-        start = 0, end = BOARD_SIZE;
+        if (entry->max_val > *max_val)
+            *max_val = entry->max_val;
+    }
 
-    else
-        start = BOARD_SIZE - 1, end = -1;
+    return dest;
+}
+
+/**
+ * @brief Gathers the cells of a column of the packed game board into a row.
+ *
+ * @details Masks the cells of the column, which lie 16 bits apart, and
+ * multiplies them such that the shifted copies of the cells land next to
+ * each other in the upper 16 bits. The other copies fall into the distinct
+ * cells below, or beyond the word, without any carries into the result.
+ *
+ * @param board The packed game board.
+ * @param col Index of the column.
+ *
+ * @return The cells of the column from the top to the bottom, laid out
+ * as a row from the left to the right.
+ */
+static inline row_t gather_col(board_t board, index_t col)
+{
+    return ((board >> (col * CELL_BITS)) & 0x000F000F000F000FULL) * 0x0001001001001000ULL >> 48;
+}
+
+/**
+ * @brief Moves the tiles within each column of the game board.
+ *
+ * @details Gathers each column into a row for looking up its transition,
+ * whose resultant column is placed back directly, such that a vertical
+ * move requires no transposition of the game board.
+ *
+ * @param board The packed game board.
+ * @param table Pointer to the column transition table for the direction.
+ * @param result Pointer to the MoveResult struct for storing the
+ * score gained and the number of merges.
+ * @param max_val Pointer to store the maximum resultant value.
+ *
+ * @return The resultant game board.
+ */
+static inline board_t move_cols(
+    board_t board, const ColMove *table, MoveResult *result, cell_t *max_val)
+{
+    const ColMove *entry;
+    board_t dest = 0;
 
     for (index_t i = 0; i < BOARD_SIZE; ++i)
     {
-        // -1 is used as a special value to signify unavailability
-        // of a compatible cell for operation.
-        last = -1;
+        entry = &table[gather_col(board, i)];
+        dest |= entry->col << (i * CELL_BITS);
 
-        for (index_t j = start; j != end; j += dir)
-        {
-            if (!game->board[j][i])
-                continue;
-
-            else if (last == -1 || game->board[j][i] != game->board[last][i])
-            {
-                last = j;
-                continue;
-            }
+        result->score += entry->score;
+        result->merges += entry->merges;
 
-            // Updates the game metadata and operations counter, and
-            // resets the "last" variable to signify unavailability.
+        if (entry->max_val > *max_val)
+            *max_val = entry->max_val;
+    }
 
-            game->board[last][i] *= 2;
-            game->board[j][i] = 0;
+    return dest;
+}
 
-            if (game->board[last][i] > game->max_val)
-                game->max_val = game->board[last][i];
+/**
+ * @brief Applies the accumulated move result to the game data.
+ *
+ * @param game Pointer to the Game struct comprising the game data.
+ * @param board The resultant game board.
+ * @param max_val The maximum resultant value across all the rows.
+ * @param result Pointer to the MoveResult struct comprising the result.
+ */
+static inline void apply_move(Game *game, board_t board, cell_t max_val, MoveResult *result)
+{
+    // The move is only considered to have changed the game board if the
+    // resultant board differs, which is exact irrespective of the merges.
+    result->changed = board != game->board;
 
-            game->score += game->board[last][i];
-            last = -1;
+    if (max_val > game->max_val)
+        game->max_val = max_val;
 
-            operated = true;
-        }
-    }
+    // Each merge frees up exactly one cell on the game board.
+    game->empty += result->merges;
 
-    return operated;
+    game->score += result->score;
+    game->board = board;
 }
 
 /**
  * @brief Horizontally moves tiles based on the specified direction.
  *
+ * @details Merges adjacent equal tiles, and moves the tiles horizontally
+ * in the specified direction (left/right) by looking up the precomputed
+ * transition of each row, and updates the game metadata.
+ *
  * @param game Pointer to the Game struct comprising the game data.
  * @param to_left Boolean value to indicate whether to perform
  * the operation from right to left or from left to right.
  *
- * @return Boolean value indicating whether any operations were performed.
+ * @return MoveResult struct comprising the score gained, the number of
+ * merges and whether the game board was changed by the operation.
  */
-bool move_horizontal(Game *game, bool to_left)
+MoveResult move_horizontal(Game *game, bool to_left)
 {
-    index_t start, end, inx_0;
-    index_t dir = to_left ? 1 : -1;
-
-    bool operated = false;
+    MoveResult result = {0};
+    cell_t max_val = 0;
 
-    // The following conditional statements defined the starting and
-    // ending index for the operation based on the specified direction.
+    board_t board = move_rows(game->board, row_moves[!to_left], &result, &max_val);
 
-    if (to_left)
-        start = 0, end = BOARD_SIZE;
+    apply_move(game, board, max_val, &result);
+    return result;
+}
 
-    else
-        start = BOARD_SIZE - 1, end = -1;
+/**
+ * @brief Vertically moves the tiles based on the specified direction.
+ *
+ * @details Merges adjacent equal tiles, and moves the tiles vertically in
+ * the specified direction (top/bottom) by looking up the precomputed
+ * transition of each column, where moving to the top corresponds to moving
+ * a row to the left, and updates the game metadata.
+ *
+ * @param game Pointer to the Game struct comprising the game data.
+ * @param to_top Boolean value to indicate whether to perform
+ * the operation from bottom to top or from top to bottom.
+ *
+ * @return MoveResult struct comprising the score gained, the number of
+ * merges and whether the game board was changed by the operation.
+ */
+MoveResult move_vertical(Game *game, bool to_top)
+{
+    MoveResult result = {0};
+    cell_t max_val = 0;
 
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
-    {
-        // -1 is used as a special value to indicate the absence
-        // of empty tiles before the current position.
-        inx_0 = -1;
+    board_t board = move_cols(game->board, col_moves[!to_top], &result, &max_val);
 
-        for (index_t j = start; j != end; j += dir)
-        {
-            if (game->board[i][j] && inx_0 != -1)
-            {
-                // Swaps the tiles, updates the operations counter and updates
-                // inx_0 by 1 in the direction of operation as the next tile is
-                // always meant to be zero.
+    apply_move(game, board, max_val, &result);
+    return result;
+}
 
-                game->board[i][inx_0] = game->board[i][j];
-                game->board[i][j] = 0;
+/**
+ * @brief Moves the tiles in the specified direction.
+ *
+ * @param game Pointer to the Game struct comprising the game data.
+ * @param dir Index of the direction of the move.
+ *
+ * @return MoveResult struct comprising the score gained, the number of
+ * merges and whether the game board was changed by the operation.
+ */
+MoveResult move_board(Game *game, dir_t dir)
+{
+    if (!is_packed(game))
+    {
+        MoveResult result = move_grid(game->grid, game->size, dir, &game->max_val);
 
-                inx_0 += dir;
-                operated = true;
-            }
+        game->score += result.score;
+        game->empty += result.merges;
 
-            else if (!game->board[i][j] && inx_0 == -1)
-                inx_0 = j;
-        }
+        return result;
     }
 
-    return operated;
+    if (dir == DIR_LEFT || dir == DIR_RIGHT)
+        return move_horizontal(game, dir == DIR_LEFT);
+
+    return move_vertical(game, dir == DIR_UP);
 }
 
 /**
- * @brief Vertically moves the tiles based on the specified direction.
+ * @brief Computes the packed game board resulting from a move.
  *
- * @param game Pointer to the Game struct comprising the game data.
- * @param to_top Boolean value to indicate whether to perform
- * the operation from bottom to top or from top to bottom.
+ * @details Only looks up the resultant rows or columns in the transition
+ * tables, without accumulating the score or updating any game data, for searching
+ * over the successive game boards without a Game struct.
  *
- * @return Boolean value indicating whether any operations were performed.
+ * @param board The packed game board.
+ * @param dir Index of the direction of the move.
+ *
+ * @return The resultant game board, which equals the specified
+ * game board if the move does not change the game board.
  */
-bool move_vertical(Game *game, bool to_top)
+board_t shift_board(board_t board, dir_t dir)
 {
-    index_t start, end, inx_0;
-    index_t dir = to_top ? 1 : -1;
+    bool reverse = dir == DIR_RIGHT || dir == DIR_DOWN;
+    board_t dest = 0;
 
-    bool operated = false;
+    if (dir == DIR_LEFT || dir == DIR_RIGHT)
+    {
+        const RowMove *table = row_moves[reverse];
 
-    // The following conditional statements define the starting and
-    // ending index for the operation absed on the specified direction.
+        for (index_t i = 0; i < BOARD_SIZE; ++i)
+            dest |= (board_t)table[(board >> (i * ROW_BITS)) & ROW_MASK].row << (i * ROW_BITS);
 
-    if (to_top)
-        start = 0, end = BOARD_SIZE;
+        return dest;
+    }
 
-    else
-        start = BOARD_SIZE - 1, end = -1;
+    const ColMove *table = col_moves[reverse];
 
     for (index_t i = 0; i < BOARD_SIZE; ++i)
-    {
-        // -1 is used as a special value to indicate the absence
-        // of empty tiles before the current position.
-        inx_0 = -1;
+        dest |= table[gather_col(board, i)].col << (i * CELL_BITS);
 
-        for (index_t j = start; j != end; j += dir)
-        {
-            if (game->board[j][i] && inx_0 != -1)
-            {
-                // Swaps the tiles, updates the operations counter and updates
-                // "inx_0" by 1 in the direction of operation as the subsequent
-                // tile is always meant to be zero.
-
-                game->board[inx_0][i] = game->board[j][i];
-                game->board[j][i] = 0;
+    return dest;
+}
 
-                inx_0 += dir;
-                operated = true;
-            }
+/**
+ * @brief Selects the position of the specified set bit within the mask.
+ *
+ * @details Uses the BMI2 parallel bit deposit instruction if available,
+ * and otherwise narrows down the position with a fixed sequence of masked
+ * population counts over the halves of the mask, without any branches.
+ *
+ * @param mask The mask comprising the set bits.
+ * @param k Zero-based index of the set bit to be selected, which must be
+ * less than the number of set bits in the mask.
+ * @param bits Number of the lower bits of the mask which can be set, as
+ * a power of 2, such that narrower masks require fewer steps.
+ *
+ * @return Position of the selected bit within the mask.
+ */
+static inline index_t select_bit(uint64_t mask, uint8_t k, uint8_t bits)
+{
+#ifdef __BMI2__
+    (void)bits;
+    return __builtin_ctzll(_pdep_u64(1ULL << k, mask));
+#else
+    index_t pos = 0;
 
-            else if (!game->board[j][i] && inx_0 == -1)
-                inx_0 = j;
-        }
+    for (uint8_t width = bits >> 1; width; width >>= 1)
+    {
+        // Skips the lower half of the remaining mask if the bit lies
+        // within the upper half, computed with masks over comparisons.
+        uint8_t cnt = __builtin_popcountll(mask & ((1ULL << width) - 1));
+        uint8_t skip = -(uint8_t)(k >= cnt);
+
+        k -= cnt & skip;
+        pos += width & skip;
+        mask >>= width & skip;
     }
 
-    return operated;
+    return pos;
+#endif
 }
 
 /**
  * @brief Randomly places the value 2 at an empty tile on the game board.
+ *
+ * @details The value is stored as its base-2 logarithm, i.e. 1, in
+ * accordance with the packed representation of the game board. The tile
+ * is selected directly from the mask of the empty cells on the game board
+ * without collecting the positions of the empty cells.
+ *
+ * The number of empty cells is maintained in the Game struct across the
+ * moves and the placements, as each merge frees up a single cell. The mask
+ * of legal moves is looked up again for the complete game board after the
+ * placement, which takes 8 row lookups on the packed game board and costs
+ * less than carrying the legal directions of the lines through every move.
+ *
  * @param game Pointer to the Game struct comprising the game data.
  *
- * @return Boolean value signifying the presence of empty
- * tiles after the value has been placed on the game board.
+ * @return Number of empty cells remaining on the game
+ * board after the value has been placed.
  */
-bool place_random(Game *game)
+len_t place_random(Game *game)
 {
-    index_t positions[BOARD_SIZE * BOARD_SIZE];
-    index_t ctr = 0;
-
-    // Searches for empty tiles on the game board and adds
-    // their positions in the array for random selection.
+    len_t cnt = game->empty;
 
-    for (index_t i = 0; i < BOARD_SIZE; ++i)
+    if (cnt)
     {
-        for (index_t j = 0; j < BOARD_SIZE; ++j)
+        index_t pos;
+
+        if (!is_packed(game))
         {
-            if (game->board[i][j])
-                continue;
+            uint64_t mask = grid_empty_mask(game->grid, game->size);
 
-            positions[ctr++] = i * BOARD_SIZE + j;
+            pos = select_bit(mask, random_range(&game->rng, cnt--), 64);
+            game->grid[pos] = 1;
         }
-    }
 
-    if (!ctr)
-        return false;
+        else
+        {
+            pos = select_bit(empty_mask(game->board), random_range(&game->rng, cnt--), 16);
+            game->board |= (board_t)1 << (pos * CELL_BITS);
+        }
+    }
 
-    index_t pos = positions[rand() % ctr];
-    game->board[pos / BOARD_SIZE][pos % BOARD_SIZE] = 2;
+    game->empty = cnt;
+    game->legal = is_packed(game) ? legal_moves(game->board)
+                                  : grid_legal_moves(game->grid, game->size);
 
-    return ctr > 1;
+    return cnt;
 }
 
 /**
- * @brief Checks if the game is over.
+ * @brief Computes the mask of the moves which change the game board.
  *
- * @param game Pointer to the Game struct comprising the game data.
- * @param cell_empty Whether there is any empty cell on the
- * game board, to indicate that the game is still not over.
+ * @details Looks up whether each row of the game board can be moved in
+ * either horizontal direction, and similarly for each row of the transposed
+ * game board for the vertical directions.
  *
- * @return Boolean value signifying whether the game is over.
+ * @param board The packed game board.
+ * @return Mask with the bits set at the indices of the legal directions.
  */
-bool is_game_over(Game *game, bool cell_empty)
+uint8_t legal_moves(board_t board)
 {
-    if (cell_empty)
-        return false;
-
-    // Iterates though the game board looking up for equal adjacent
-    // tiles that can be merged to check if the game is still not over.
+    board_t trans = transpose(board);
+    uint8_t horizontal = 0, vertical = 0;
 
     for (index_t i = 0; i < BOARD_SIZE; ++i)
     {
-        for (index_t j = 0; j < BOARD_SIZE - 1; ++j)
-        {
-            if (game->board[i][j] == game->board[i][j + 1] ||
-                game->board[j][i] == game->board[j + 1][i])
-                return false;
-        }
+        horizontal |= row_legal[(board >> (i * ROW_BITS)) & ROW_MASK];
+        vertical |= row_legal[(trans >> (i * ROW_BITS)) & ROW_MASK];
     }
 
-    return true;
+    // The vertical directions directly succeed the horizontal directions,
+    // with the upward direction corresponding to the leftward direction.
+    return horizontal << DIR_LEFT | vertical << DIR_UP;
+}
+
+/**
+ * @brief Checks if the game is over.
+ *
+ * @details The game is over if none of the moves change the game board,
+ * which is determined from the mask of legal moves maintained in the Game
+ * struct, without scanning the game board.
+ *
+ * @param game Pointer to the Game struct comprising the game data.
+ * @return Boolean value signifying whether the game is over.
+ */
+bool is_game_over(Game *game)
+{
+    return !game->legal;
 }
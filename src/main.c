@@ -11,16 +11,35 @@
  */
 
 #include <ncurses.h>
+#include <stdio.h>
 #include <time.h>
 #include <stdlib.h>
 
 #include "shared.h"
 #include "handlers.h"
+#include "hint.h"
+#include "ai.h"
+#include "ntuple.h"
 #include "consts.h"
 #include "logic.h"
+#include "options.h"
+#include "simulate.h"
+#include "train.h"
+#include "soak.h"
+#include "stats.h"
+#include "random.h"
 
 #include "interface/shared.h"
 #include "interface/core.h"
+#include "interface/board.h"
+
+// Stores the latency statistics referenced by the
+// game board handler if the statistics are requested.
+static LatencyStats latency;
+
+// Stores the n-tuple network evaluating the search for the hints if
+// the weights file is specified.
+static Network network;
 
 // Stores references to the screen handler functions.
 handler_t (*handlers[])(Dimension *) = {
@@ -37,23 +56,63 @@ handler_t (*handlers[])(Dimension *) = {
 /**
  * @brief Sets up the TUI environment and game-related data structures.
  *
- * @details Sets up TUI environment with ncurses, seeds the random number
- * generator, and sets up the Game struct for handling game-related data.
+ * @details Sets up TUI environment with ncurses, precomputes the row
+ * transition tables and the tile labels, and sets up the Game struct for
+ * handling game-related data along with seeding its random number generator
+ * with the specified seed, or the current time if no seed is specified. The
+ * screens are displayed on the null device for the soak test, and the
+ * n-tuple network is loaded for the hints if its weights are specified.
+ *
+ * @param opts Pointer to the Options struct comprising the options.
+ * @return Boolean value indicating whether the setup was successful.
  */
-void setup(void)
+bool setup(Options *opts)
 {
-    srand(time(NULL));
+    FILE *output = NULL;
+
+    if (opts->soak && !(output = fopen("/dev/null", "w")))
+        return false;
+
+    // The weights are loaded before the TUI environment is set up,
+    // such that the failure is reported on the terminal.
+    if (opts->weights)
+    {
+        if (!load_network(&network, opts, false))
+        {
+            fprintf(stderr, "Unable to load the weights from '%s'.\n", opts->weights);
+            return false;
+        }
+
+        set_network(&network);
+    }
+
+    init_move_tables();
+    init_tile_labels();
 
     // Sets up the TUI environment and the required color pairs.
-    init_screen();
+    if (!init_screen(output))
+        return false;
+
     init_pair(COLOR_SELECT, COLOR_BLACK, COLOR_WHITE);
 
     game = (Game){
-        .board = create_board(),
+        .size = opts->size,
         .init = FALSE,
         .score = 0,
         .max_val = 0,
     };
+
+    seed_rng(&game.rng, opts->seeded ? opts->seed : (uint64_t)time(NULL));
+
+    if (opts->stats)
+        latency_stats = &latency;
+
+    // The hints are only searched on the packed game board, and are
+    // simply unavailable if the worker cannot be started.
+    if (opts->size == BOARD_SIZE && !opts->soak)
+        start_hints();
+
+    return true;
 }
 
 /**
@@ -61,16 +120,47 @@ void setup(void)
  */
 void clean(void)
 {
-    free_board(game.board);
+    stop_hints();
+    free_windows();
     endwin();
+
+    set_network(NULL);
+    free_network(&network);
 }
 
 /**
  * @brief Main function for program execution.
+ *
+ * @details Parses the command-line options, and runs the headless
+ * simulation, the training or the soak test if requested, or the
+ * interactive TUI game otherwise.
  */
-int main(void)
+int main(int argc, char *argv[])
 {
-    setup();
+    Options opts;
+
+    if (!parse_options(argc, argv, &opts))
+        return EXIT_FAILURE;
+
+    // The simulation runs headlessly without setting up the TUI environment.
+    if (opts.simulate)
+        return run_simulation(&opts) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if (opts.train)
+        return run_training(&opts) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if (!setup(&opts))
+        return EXIT_FAILURE;
+
+    // The soak test cycles through the screens in place of the game
+    // execution loop, without waiting for any user input.
+    if (opts.soak)
+    {
+        run_soak(&opts);
+        clean();
+
+        return EXIT_SUCCESS;
+    }
 
     Dimension scr_dim;
 
@@ -83,13 +173,8 @@ int main(void)
     {
         clear();
 
-        scr_dim = (Dimension){
-            .height = getmaxy(stdscr),
-            .width = getmaxx(stdscr),
-        };
-
         // Displays a warning while the screen dimensions are unsupported.
-        if (scr_dim.height < MIN_HEIGHT || scr_dim.width < MIN_WIDTH)
+        if (!read_screen_dim(&scr_dim, game.size))
         {
             mvprintw(0, 0, "%s", scr_dim_warning);
             refresh();
@@ -97,6 +182,7 @@ int main(void)
             while (getch() != KEY_RESIZE)
                 ;
 
+            debounce_resize();
             continue;
         }
 
@@ -107,5 +193,12 @@ int main(void)
 
     clean();
 
+    // The statistics are written once the TUI environment is exited.
+    if (opts.stats && !dump_stats(opts.stats, &latency, &frame_stats))
+    {
+        fprintf(stderr, "Unable to write the statistics to '%s'.\n", opts.stats);
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,313 @@
+/**
+ * @file ntuple.c
+ * @brief Defines the n-tuple network for evaluating the game boards.
+ *
+ * @details This module defines a value function over the packed game board
+ * as the sum of the weights selected by a fixed set of tuples of cells,
+ * where the values of the cells covered by a tuple index into its table of
+ * weights. Each tuple is placed at all the rotations and reflections of its
+ * cells, which share the same weights, such that the symmetric game boards
+ * are evaluated identically.
+ *
+ * The weights are read and updated with relaxed atomic operations, such
+ * that multiple threads can train the same network without any locks,
+ * at the cost of occasionally losing a concurrent update of a weight.
+ *
+ * The weights file is mapped into memory instead of being read, such that
+ * the network is available immediately irrespective of its size, and its
+ * pages are shared across all the processes using the same weights file.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ntuple.h"
+#include "shared.h"
+#include "consts.h"
+
+// Cells covered by the tuples in row-major order, comprising the straight
+// and the rectangular shapes along the edge and the adjacent row.
+static const uint8_t tuples[NTUPLE_CNT][NTUPLE_LEN] = {
+    {0, 1, 2, 3, 4, 5},
+    {4, 5, 6, 7, 8, 9},
+    {0, 1, 2, 4, 5, 6},
+    {4, 5, 6, 8, 9, 10},
+};
+
+// Stores the bit offsets of the cells within the packed game board for
+// every symmetric placement of each tuple, grouped by the tuples.
+static uint8_t shifts[NTUPLE_CNT * NTUPLE_SYMS][NTUPLE_LEN];
+
+// Size of the weights of all the tuples in bytes.
+static const size_t weights_size = (size_t)NTUPLE_CNT * NTUPLE_SIZE * sizeof(float);
+
+/**
+ * @brief Computes the offsets of the cells for every placement of the tuples.
+ *
+ * @details Each placement combines the transposition with the horizontal
+ * and the vertical reflections of the cells of the tuple, selected by the
+ * bits of its index.
+ */
+static void init_shifts(void)
+{
+    for (uint8_t i = 0; i < NTUPLE_CNT * NTUPLE_SYMS; ++i)
+    {
+        uint8_t sym = i % NTUPLE_SYMS;
+
+        for (index_t j = 0; j < NTUPLE_LEN; ++j)
+        {
+            index_t row = tuples[i / NTUPLE_SYMS][j] / BOARD_SIZE;
+            index_t col = tuples[i / NTUPLE_SYMS][j] % BOARD_SIZE;
+
+            if (sym & 1)
+            {
+                index_t temp = row;
+                row = col, col = temp;
+            }
+
+            if (sym & 2)
+                col = BOARD_SIZE - 1 - col;
+
+            if (sym & 4)
+                row = BOARD_SIZE - 1 - row;
+
+            shifts[i][j] = (row * BOARD_SIZE + col) * CELL_BITS;
+        }
+    }
+}
+
+/**
+ * @brief Computes the index of the weight selected by a placement of a
+ * tuple, by concatenating the values of the cells it covers.
+ *
+ * @param board The packed game board.
+ * @param shift Offsets of the cells covered by the placement.
+ *
+ * @return Index within the table of weights of the tuple.
+ */
+static inline uint32_t tuple_index(board_t board, const uint8_t shift[NTUPLE_LEN])
+{
+    uint32_t index = 0;
+
+    for (index_t i = 0; i < NTUPLE_LEN; ++i)
+        index |= ((board >> shift[i]) & CELL_MASK) << (i * CELL_BITS);
+
+    return index;
+}
+
+/**
+ * @brief Sets up the n-tuple network with all the weights set to 0.
+ *
+ * @param net Pointer to the Network struct to be set up.
+ * @return Boolean value indicating whether the setup was successful.
+ */
+bool init_network(Network *net)
+{
+    init_shifts();
+
+    net->weights = (float *)calloc((size_t)NTUPLE_CNT * NTUPLE_SIZE, sizeof(float));
+    net->mapped = false;
+
+    return net->weights;
+}
+
+/**
+ * @brief Frees the weights of the n-tuple network, or unmaps
+ * them if they are mapped from the weights file.
+ *
+ * @param net Pointer to the Network struct.
+ */
+void free_network(Network *net)
+{
+    if (net->mapped)
+        munmap(net->weights, weights_size);
+
+    else
+        free(net->weights);
+
+    net->weights = NULL, net->mapped = false;
+}
+
+/**
+ * @brief Maps the n-tuple network from the specified weights file.
+ *
+ * @details Only the header of the file is read and validated, and the
+ * weights are mapped in place, such that the pages are loaded on demand
+ * and shared through the page cache with the other processes mapping the
+ * same file. Huge pages are requested for the mapping if specified in the
+ * options, which the weights are aligned for within the file, and the
+ * outcome of the request is reported if verbose output is enabled.
+ *
+ * A writable mapping is private to the process, such that the updated
+ * weights are never written back to the file.
+ *
+ * @param net Pointer to the Network struct to be set up.
+ * @param opts Pointer to the Options struct comprising the path to the
+ * weights file.
+ * @param writable Boolean value indicating whether the weights are to
+ * be updated, as for continuing the training.
+ *
+ * @return Boolean value indicating whether the network was loaded.
+ */
+bool load_network(Network *net, const Options *opts, bool writable)
+{
+    int fd = open(opts->weights, O_RDONLY | O_CLOEXEC);
+    WeightsHeader header;
+    struct stat info;
+
+    if (fd < 0)
+        return false;
+
+    bool valid = pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+                 !fstat(fd, &info) && header.magic == WEIGHTS_MAGIC &&
+                 header.version == WEIGHTS_VERSION && header.cnt == NTUPLE_CNT &&
+                 header.len == NTUPLE_LEN && !memcmp(header.tuples, tuples, sizeof(tuples)) &&
+                 header.size == weights_size && header.offset && !(header.offset % WEIGHTS_ALIGN) &&
+                 (uint64_t)info.st_size >= header.size &&
+                 header.offset <= (uint64_t)info.st_size - header.size;
+
+    void *map = MAP_FAILED;
+
+    if (valid)
+        map = mmap(NULL, weights_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                   writable ? MAP_PRIVATE : MAP_SHARED, fd, header.offset);
+
+    // The mapping remains valid once the file is closed.
+    close(fd);
+
+    if (map == MAP_FAILED)
+        return false;
+
+    if (opts->huge_pages)
+    {
+        // The weights remain usable with the regular pages if the huge
+        // pages are not available, such that the failure is not fatal.
+#ifdef MADV_HUGEPAGE
+        bool advised = !madvise(map, weights_size, MADV_HUGEPAGE);
+#else
+        bool advised = false;
+        errno = ENOSYS;
+#endif
+
+        if (opts->verbose && advised)
+            fprintf(stderr, "Requested huge pages for the weights.\n");
+
+        else if (opts->verbose)
+            fprintf(stderr, "Unable to request huge pages for the weights: %s.\n", strerror(errno));
+    }
+
+    if (opts->verbose)
+        fprintf(stderr, "Mapped %zu MiB of weights from '%s' as %s.\n", weights_size >> 20,
+                opts->weights, writable ? "a private copy" : "shared read-only pages");
+
+    init_shifts();
+
+    net->weights = (float *)map;
+    net->mapped = true;
+
+    return true;
+}
+
+/**
+ * @brief Writes the n-tuple network to the specified weights file.
+ *
+ * @details The network is written to a temporary file which then replaces
+ * the weights file, such that the processes which have mapped the previous
+ * weights file retain it intact. The gap between the header and the weights
+ * is skipped over without being written.
+ *
+ * @param net Pointer to the Network struct.
+ * @param path Path to the weights file, which is replaced if it exists.
+ *
+ * @return Boolean value indicating whether the network was written.
+ */
+bool save_network(const Network *net, const char *path)
+{
+    char *temp = (char *)malloc(strlen(path) + sizeof(".tmp"));
+    WeightsHeader header;
+
+    if (!temp)
+        return false;
+
+    sprintf(temp, "%s.tmp", path);
+    FILE *file = fopen(temp, "wb");
+
+    if (!file)
+    {
+        free(temp);
+        return false;
+    }
+
+    // The padding of the header is cleared to keep the file deterministic.
+    memset(&header, 0, sizeof(header));
+
+    header.magic = WEIGHTS_MAGIC, header.version = WEIGHTS_VERSION;
+    header.cnt = NTUPLE_CNT, header.len = NTUPLE_LEN;
+    header.offset = WEIGHTS_ALIGN, header.size = weights_size;
+    memcpy(header.tuples, tuples, sizeof(tuples));
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   !fseek(file, header.offset, SEEK_SET) &&
+                   fwrite(net->weights, weights_size, 1, file) == 1;
+
+    written = !fclose(file) && written && !rename(temp, path);
+
+    if (!written)
+        remove(temp);
+
+    free(temp);
+    return written;
+}
+
+/**
+ * @brief Evaluates the packed game board with the n-tuple network.
+ * @return Sum of the weights selected by all the placements of the tuples.
+ */
+float evaluate_network(const Network *net, board_t board)
+{
+    float sum = 0, value;
+
+    for (uint8_t i = 0; i < NTUPLE_CNT * NTUPLE_SYMS; ++i)
+    {
+        const float *table = net->weights + (size_t)(i / NTUPLE_SYMS) * NTUPLE_SIZE;
+
+        __atomic_load(&table[tuple_index(board, shifts[i])], &value, __ATOMIC_RELAXED);
+        sum += value;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Adjusts the weights selected by the packed game board.
+ *
+ * @details Each weight is read and written back separately instead of
+ * being updated atomically, as an update lost to a concurrent update of
+ * the same weight is negligible during the training.
+ *
+ * @param net Pointer to the Network struct.
+ * @param board The packed game board.
+ * @param delta Amount added to each of the selected weights.
+ */
+void update_network(Network *net, board_t board, float delta)
+{
+    float value;
+
+    for (uint8_t i = 0; i < NTUPLE_CNT * NTUPLE_SYMS; ++i)
+    {
+        float *weight = net->weights + (size_t)(i / NTUPLE_SYMS) * NTUPLE_SIZE +
+                        tuple_index(board, shifts[i]);
+
+        __atomic_load(weight, &value, __ATOMIC_RELAXED);
+        value += delta;
+        __atomic_store(weight, &value, __ATOMIC_RELAXED);
+    }
+}
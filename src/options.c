@@ -0,0 +1,289 @@
+/**
+ * @file options.c
+ * @brief Defines functions for parsing the command-line options.
+ *
+ * @details This module defines functions for parsing the command-line
+ * options specified for the program execution, which select between the
+ * interactive TUI game and the headless modes of execution.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "options.h"
+#include "shared.h"
+#include "consts.h"
+
+static const char *usage = "Usage: %s [OPTIONS]\n\
+\n\
+Options:\n\
+  --simulate N       Play N games headlessly and report the statistics.\n\
+  --policy NAME      Move policy for the simulation: random, greedy, cyclic\n\
+                     or expectimax.\n\
+  --depth N          Depth of the expectimax search, from 1 to 8 (default: 3).\n\
+  --time MS          Time budget of the expectimax search per move in\n\
+                     milliseconds, deepening the search iteratively\n\
+                     within it in place of the fixed depth.\n\
+  --threads N        Number of threads for the expectimax search, from 1\n\
+                     to 64 (default: 1).\n\
+  --table MB         Memory budget of the transposition table of the search\n\
+                     in MiB, or 0 to disable it (default: 64).\n\
+  --weights FILE     Weights file of the n-tuple network evaluating the\n\
+                     expectimax search in place of the heuristic.\n\
+  --train N          Train the n-tuple network with N games of self-play\n\
+                     across the threads and write it to the weights file.\n\
+  --huge-pages       Request huge pages for the weights of the network.\n\
+  --seed N           Seed for the random number generator.\n\
+  --size N           Size of the game board, from 3 to 8 (default: 4).\n\
+  --soak N           Cycle through the screens N times headlessly and\n\
+                     report the memory usage.\n\
+  --stats FILE       Display the input latency statistics in an overlay\n\
+                     and write them to FILE on exit.\n\
+  --verbose          Report the details of loading the weights.\n\
+  --help             Display this message and exit.\n";
+
+static const struct option long_options[] = {
+    {"simulate", required_argument, NULL, 's'},
+    {"policy", required_argument, NULL, 'p'},
+    {"depth", required_argument, NULL, 'd'},
+    {"table", required_argument, NULL, 'b'},
+    {"threads", required_argument, NULL, 'j'},
+    {"time", required_argument, NULL, 'm'},
+    {"weights", required_argument, NULL, 'w'},
+    {"train", required_argument, NULL, 'l'},
+    {"huge-pages", no_argument, NULL, 'g'},
+    {"verbose", no_argument, NULL, 'v'},
+    {"seed", required_argument, NULL, 'r'},
+    {"size", required_argument, NULL, 'n'},
+    {"soak", required_argument, NULL, 'k'},
+    {"stats", required_argument, NULL, 't'},
+    {"help", no_argument, NULL, 'h'},
+    {NULL, 0, NULL, 0},
+};
+
+/**
+ * @brief Parses a positive integer from the specified option argument.
+ *
+ * @param arg The option argument to be parsed.
+ * @param value Pointer to store the parsed value.
+ *
+ * @return Boolean value indicating whether the argument is valid.
+ */
+bool parse_count(const char *arg, uint32_t *value)
+{
+    char *end;
+    unsigned long parsed = strtoul(arg, &end, 10);
+
+    if (*arg == '-' || *end || !parsed || parsed > UINT32_MAX)
+        return false;
+
+    *value = parsed;
+    return true;
+}
+
+/**
+ * @brief Parses a size from the specified option argument.
+ *
+ * @details Only accepts decimal digits, such that signs, whitespace and
+ * hexadecimal prefixes are rejected, and accepts 0 unlike the counts.
+ *
+ * @param arg The option argument to be parsed.
+ * @param max Largest valid value of the size.
+ * @param value Pointer to store the parsed value.
+ *
+ * @return Boolean value indicating whether the argument is valid.
+ */
+static bool parse_size(const char *arg, uint32_t max, uint32_t *value)
+{
+    char *end;
+
+    errno = 0;
+    unsigned long parsed = strtoul(arg, &end, 10);
+
+    if (*arg < '0' || *arg > '9' || *end || errno == ERANGE || parsed > max)
+        return false;
+
+    *value = parsed;
+    return true;
+}
+
+/**
+ * @brief Parses a 64-bit seed from the specified option argument.
+ *
+ * @param arg The option argument to be parsed.
+ * @param seed Pointer to store the parsed seed.
+ *
+ * @return Boolean value indicating whether the argument is valid.
+ */
+static bool parse_seed(const char *arg, uint64_t *seed)
+{
+    char *end;
+
+    errno = 0;
+    unsigned long long parsed = strtoull(arg, &end, 0);
+
+    if (*arg == '-' || !*arg || *end || (parsed == ULLONG_MAX && errno == ERANGE))
+        return false;
+
+    *seed = parsed;
+    return true;
+}
+
+/**
+ * @brief Parses the command-line options into the Options struct.
+ *
+ * @details Populates the Options struct with the default values, and
+ * overrides them with the specified options. Displays the usage message
+ * if the options are invalid or if the help option is specified.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array comprising the command-line arguments.
+ * @param opts Pointer to the Options struct to be populated.
+ *
+ * @return Boolean value indicating whether the program should proceed.
+ */
+bool parse_options(int argc, char *argv[], Options *opts)
+{
+    *opts = (Options){
+        .simulate = 0,
+        .soak = 0,
+        .train = 0,
+        .policy = "random",
+        .stats = NULL,
+        .weights = NULL,
+        .seed = 0,
+        .seeded = false,
+        .size = BOARD_SIZE,
+        .depth = AI_DEPTH,
+        .threads = 1,
+        .budget = 0,
+        .table = TABLE_BUDGET,
+        .huge_pages = false,
+        .verbose = false,
+    };
+
+    uint32_t size, depth, threads;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "", long_options, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            if (parse_count(optarg, &opts->simulate))
+                break;
+
+            fprintf(stderr, "%s: invalid number of games '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'k':
+            if (parse_count(optarg, &opts->soak))
+                break;
+
+            fprintf(stderr, "%s: invalid number of transitions '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'l':
+            if (parse_count(optarg, &opts->train))
+                break;
+
+            fprintf(stderr, "%s: invalid number of games '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'p':
+            opts->policy = optarg;
+            break;
+
+        case 'w':
+            opts->weights = optarg;
+            break;
+
+        case 't':
+            opts->stats = optarg;
+            break;
+
+        case 'g':
+            opts->huge_pages = true;
+            break;
+
+        case 'v':
+            opts->verbose = true;
+            break;
+
+        case 'r':
+            if (parse_seed(optarg, &opts->seed))
+            {
+                opts->seeded = true;
+                break;
+            }
+
+            fprintf(stderr, "%s: invalid seed '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'n':
+            if (parse_count(optarg, &size) && size >= MIN_BOARD_SIZE && size <= MAX_BOARD_SIZE)
+            {
+                opts->size = size;
+                break;
+            }
+
+            fprintf(stderr, "%s: invalid board size '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'd':
+            if (parse_count(optarg, &depth) && depth <= MAX_AI_DEPTH)
+            {
+                opts->depth = depth;
+                break;
+            }
+
+            fprintf(stderr, "%s: invalid search depth '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'm':
+            if (parse_count(optarg, &opts->budget))
+                break;
+
+            fprintf(stderr, "%s: invalid time budget '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'j':
+            if (parse_count(optarg, &threads) && threads <= MAX_THREADS)
+            {
+                opts->threads = threads;
+                break;
+            }
+
+            fprintf(stderr, "%s: invalid number of threads '%s'\n", argv[0], optarg);
+            return false;
+
+        case 'b':
+            if (parse_size(optarg, MAX_TABLE_BUDGET, &opts->table))
+                break;
+
+            fprintf(stderr, "%s: invalid table budget '%s' (expected 0 to %u MiB)\n",
+                    argv[0], optarg, MAX_TABLE_BUDGET);
+            return false;
+
+        case 'h':
+            printf(usage, argv[0]);
+            exit(EXIT_SUCCESS);
+
+        default:
+            fprintf(stderr, usage, argv[0]);
+            return false;
+        }
+    }
+
+    if (optind < argc)
+    {
+        fprintf(stderr, usage, argv[0]);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file pool.c
+ * @brief Defines the work-stealing thread pool for the parallel search.
+ *
+ * @details This module defines a pool of persistent worker threads which
+ * perform batches of independent tasks identified by their indices. Each
+ * batch is split into contiguous ranges of tasks, one per worker, which
+ * the workers claim from the front of their own range. Once its own range
+ * is exhausted, a worker steals the tasks from the back of the ranges of
+ * the other workers, such that the workers remain busy until the complete
+ * batch is claimed irrespective of the imbalance between the tasks.
+ *
+ * The ranges are claimed with atomic compare-and-swap operations without
+ * any locks, and the mutex of the pool is only held for starting and
+ * completing the batches.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pool.h"
+#include "shared.h"
+#include "consts.h"
+
+/**
+ * @brief Claims a single task from the front or the back of the range.
+ *
+ * @param queue Pointer to the WorkQueue struct comprising the range.
+ * @param front Boolean value indicating whether to claim the task from
+ * the front of the range, as done by its owner, or from the back.
+ * @param index Pointer to store the index of the claimed task.
+ *
+ * @return Boolean value indicating whether a task was claimed.
+ */
+static bool claim_task(WorkQueue *queue, bool front, uint32_t *index)
+{
+    uint64_t range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE), next;
+
+    do
+    {
+        uint32_t low = range, high = range >> 32;
+
+        if (low >= high)
+            return false;
+
+        if (front)
+            *index = low++;
+
+        else
+            *index = --high;
+
+        next = (uint64_t)high << 32 | low;
+
+    } while (!__atomic_compare_exchange_n(
+        &queue->range, &range, next, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return true;
+}
+
+/**
+ * @brief Performs the tasks of the current batch until none are left.
+ *
+ * @details Claims the tasks from the range of the worker, and steals the
+ * tasks from the other workers once its range is exhausted, starting with
+ * the next worker to spread the thieves across the ranges. As no tasks are
+ * added to a batch once it has started, the worker returns as soon as no
+ * task can be claimed from any of the ranges.
+ *
+ * @param pool Pointer to the Pool struct comprising the batch.
+ * @param id Index of the worker within the pool.
+ */
+static void perform_tasks(Pool *pool, uint8_t id)
+{
+    uint32_t index;
+
+    while (true)
+    {
+        bool claimed = claim_task(&pool->queues[id], true, &index);
+
+        for (uint8_t i = 1; !claimed && i < pool->cnt; ++i)
+            claimed = claim_task(&pool->queues[(id + i) % pool->cnt], false, &index);
+
+        if (!claimed)
+            return;
+
+        pool->task(pool->ctx, id, index);
+    }
+}
+
+/**
+ * @brief Entry point of the worker threads.
+ *
+ * @details Waits for each new batch of tasks, performs the tasks along
+ * with the other workers, and signals the completion of the batch once
+ * the last worker has finished, until the pool is stopped.
+ *
+ * @param arg Pointer to the Worker struct of the thread.
+ */
+static void *run_worker(void *arg)
+{
+    Worker *worker = (Worker *)arg;
+    Pool *pool = worker->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (true)
+    {
+        while (pool->batch == seen && !pool->stop)
+            pthread_cond_wait(&pool->start, &pool->lock);
+
+        if (pool->stop)
+            break;
+
+        seen = pool->batch;
+        pthread_mutex_unlock(&pool->lock);
+
+        perform_tasks(pool, worker->id);
+
+        pthread_mutex_lock(&pool->lock);
+
+        if (!--pool->active)
+            pthread_cond_signal(&pool->done);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Sets up the thread pool and starts the worker threads.
+ *
+ * @param pool Pointer to the Pool struct to be set up.
+ * @param cnt Number of workers including the thread running the batches,
+ * such that a single worker signifies running the batches serially.
+ *
+ * @return Boolean value indicating whether the setup was successful.
+ */
+bool init_pool(Pool *pool, uint8_t cnt)
+{
+    *pool = (Pool){
+        .workers = (Worker *)calloc(cnt, sizeof(Worker)),
+        .queues = (WorkQueue *)aligned_alloc(CACHE_LINE, cnt * sizeof(WorkQueue)),
+        .cnt = 1,
+    };
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    if (!pool->workers || !pool->queues)
+    {
+        free_pool(pool);
+        return false;
+    }
+
+    // The count only comprises the started threads, such that the pool
+    // can be freed if any of the threads cannot be started.
+    for (; pool->cnt < cnt; ++pool->cnt)
+    {
+        Worker *worker = &pool->workers[pool->cnt];
+        *worker = (Worker){.pool = pool, .id = pool->cnt};
+
+        if (pthread_create(&worker->thread, NULL, run_worker, worker))
+        {
+            free_pool(pool);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Stops the worker threads and frees the thread pool.
+ * @param pool Pointer to the Pool struct.
+ */
+void free_pool(Pool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint8_t i = 1; i < pool->cnt; ++i)
+        pthread_join(pool->workers[i].thread, NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+
+    free(pool->workers);
+    free(pool->queues);
+
+    *pool = (Pool){0};
+}
+
+/**
+ * @brief Performs a batch of tasks across all the workers of the pool.
+ *
+ * @details Splits the tasks into contiguous ranges of equal length, one
+ * per worker, and performs the tasks on the calling thread along with the
+ * other workers, returning once all the tasks have been performed.
+ *
+ * @param pool Pointer to the Pool struct.
+ * @param task Function performing an individual task.
+ * @param ctx Pointer to the data shared by the tasks.
+ * @param len Number of tasks in the batch.
+ */
+void run_pool(Pool *pool, task_t task, void *ctx, uint32_t len)
+{
+    for (uint8_t i = 0; i < pool->cnt; ++i)
+    {
+        uint64_t low = (uint64_t)len * i / pool->cnt;
+        uint64_t high = (uint64_t)len * (i + 1) / pool->cnt;
+
+        __atomic_store_n(&pool->queues[i].range, high << 32 | low, __ATOMIC_RELAXED);
+    }
+
+    // The ranges and the tasks are published to the workers by the mutex.
+    pthread_mutex_lock(&pool->lock);
+
+    pool->task = task, pool->ctx = ctx;
+    pool->active = pool->cnt - 1;
+    ++pool->batch;
+
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    perform_tasks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->active)
+        pthread_cond_wait(&pool->done, &pool->lock);
+
+    pthread_mutex_unlock(&pool->lock);
+}
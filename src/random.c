@@ -0,0 +1,37 @@
+/**
+ * @file random.c
+ * @brief Defines functions for handling the pseudo random number generator.
+ *
+ * @details This module defines functions for seeding the xoshiro256**
+ * pseudo random number generator, whose state is owned by the individual
+ * game instances, such that independent games produce independent and
+ * reproducible sequences without sharing any global state.
+ */
+
+#include <stdint.h>
+
+#include "random.h"
+#include "shared.h"
+
+/**
+ * @brief Seeds the pseudo random number generator.
+ *
+ * @details Expands the 64-bit seed into the 256-bit generator state with
+ * the splitmix64 sequence, which guarantees a non-zero state irrespective
+ * of the seed.
+ *
+ * @param rng Pointer to the Rng struct comprising the generator state.
+ * @param seed The seed value.
+ */
+void seed_rng(Rng *rng, uint64_t seed)
+{
+    for (index_t i = 0; i < 4; ++i)
+    {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+        rng->state[i] = z ^ (z >> 31);
+    }
+}
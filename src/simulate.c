@@ -0,0 +1,440 @@
+/**
+ * @file simulate.c
+ * @brief Defines functions for the headless batch simulation mode.
+ *
+ * @details This module defines functions for playing games headlessly
+ * through the game logic using a pluggable move policy, without the TUI
+ * environment, and reporting the throughput and the distributions of the
+ * final scores and the maximum tiles across all the games.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "simulate.h"
+#include "ai.h"
+#include "logic.h"
+#include "ntuple.h"
+#include "table.h"
+#include "random.h"
+#include "stats.h"
+#include "shared.h"
+#include "consts.h"
+
+// Ranks the directions in the order in which the moves are to be attempted.
+typedef void (*policy_t)(Game *game, dir_t order[DIR_CNT], uint32_t move_cnt);
+
+// Policies marked as packed only support the game board of the default size.
+typedef struct
+{
+    const char *name;
+    policy_t rank;
+    bool packed;
+} Policy;
+
+// Stores the statistics accumulated across all the simulated games.
+typedef struct
+{
+    score_t *scores;
+    uint32_t tiles[MAX_TILE + 1];
+    uint64_t moves;
+    uint64_t nodes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t depths;
+    uint8_t max_depth;
+} SimStats;
+
+// Stores the depth and the time budget in nanoseconds of the search for
+// the expectimax policy, its transposition table, the number of nodes
+// searched and the sum and the maximum of the depths reached, as the
+// policies only receive the game.
+static uint8_t search_depth;
+static uint64_t search_budget;
+static TransTable *search_table;
+static uint64_t search_nodes;
+static uint64_t search_depths;
+static uint8_t search_max_depth;
+
+/**
+ * @brief Ranks the directions in a uniformly random order.
+ */
+static void rank_random(Game *game, dir_t order[DIR_CNT], uint32_t move_cnt)
+{
+    (void)game, (void)move_cnt;
+
+    for (dir_t i = 0; i < DIR_CNT; ++i)
+        order[i] = i;
+
+    // Shuffles the directions with the Fisher-Yates algorithm.
+    for (dir_t i = DIR_CNT - 1; i > 0; --i)
+    {
+        dir_t j = random_range(&game->rng, i + 1), temp = order[i];
+        order[i] = order[j], order[j] = temp;
+    }
+}
+
+/**
+ * @brief Ranks the directions by the score gained by the associated moves.
+ *
+ * @details Moves resulting in no change on the game board are ranked last,
+ * and ties are resolved in the order of the direction indices.
+ */
+static void rank_greedy(Game *game, dir_t order[DIR_CNT], uint32_t move_cnt)
+{
+    (void)move_cnt;
+
+    // Stores the scores offset by 1 such that 0 signifies a move
+    // resulting in no change on the game board.
+    uint64_t gain[DIR_CNT];
+
+    for (dir_t i = 0; i < DIR_CNT; ++i)
+    {
+        // The trial moves are performed on a copy of the game,
+        // leaving the game board of the game unchanged.
+        Game copy = *game;
+        MoveResult result = move_board(&copy, i);
+
+        gain[i] = result.changed ? (uint64_t)result.score + 1 : 0;
+        order[i] = i;
+    }
+
+    // Sorts the directions in descending order of the gains
+    // with insertion sort, keeping equal gains in order.
+    for (dir_t i = 1; i < DIR_CNT; ++i)
+    {
+        dir_t cur = order[i];
+        index_t j = i - 1;
+
+        for (; j >= 0 && gain[order[j]] < gain[cur]; --j)
+            order[j + 1] = order[j];
+
+        order[j + 1] = cur;
+    }
+}
+
+/**
+ * @brief Ranks the directions in a fixed cycle of left, up, right and
+ * down, starting with the direction next in the cycle at each move.
+ */
+static void rank_cyclic(Game *game, dir_t order[DIR_CNT], uint32_t move_cnt)
+{
+    (void)game;
+    static const dir_t cycle[] = {DIR_LEFT, DIR_UP, DIR_RIGHT, DIR_DOWN};
+
+    for (dir_t i = 0; i < DIR_CNT; ++i)
+        order[i] = cycle[(move_cnt + i) % DIR_CNT];
+}
+
+/**
+ * @brief Ranks the best move found by the expectimax search first,
+ * followed by the other directions in the order of their indices.
+ *
+ * @details The search deepens iteratively within the time budget if
+ * one is specified, and searches to the fixed depth otherwise.
+ */
+static void rank_expectimax(Game *game, dir_t order[DIR_CNT], uint32_t move_cnt)
+{
+    (void)move_cnt;
+
+    SearchResult result = search_budget ? search_timed(game->board, search_budget, search_table, NULL)
+                                        : search_move(game->board, search_depth, search_table);
+
+    search_nodes += result.nodes;
+    search_depths += result.depth;
+
+    if (result.depth > search_max_depth)
+        search_max_depth = result.depth;
+
+    order[0] = result.dir;
+
+    for (dir_t i = 0, j = 1; i < DIR_CNT; ++i)
+        if (i != result.dir)
+            order[j++] = i;
+}
+
+static const Policy policies[] = {
+    {"random", rank_random, false},
+    {"greedy", rank_greedy, false},
+    {"cyclic", rank_cyclic, false},
+    {"expectimax", rank_expectimax, true},
+};
+
+static const len_t policy_cnt = sizeof(policies) / sizeof(policies[0]);
+
+/**
+ * @brief Plays a single game until no more moves are possible.
+ *
+ * @details Unlike the interactive game, the game continues past the
+ * target value and only ends once no legal moves are left.
+ *
+ * @param game Pointer to the Game struct for playing the game, whose
+ * random number generator is carried over across the games.
+ * @param policy Pointer to the Policy struct for selecting the moves.
+ * @param stats Pointer to the SimStats struct for accumulating the
+ * statistics of the game.
+ *
+ * @return The final score of the game.
+ */
+static score_t play_game(Game *game, const Policy *policy, SimStats *stats)
+{
+    dir_t order[DIR_CNT];
+    uint32_t move_cnt = 0;
+
+    setup_game(game);
+
+    while (!is_game_over(game))
+    {
+        policy->rank(game, order, move_cnt);
+
+        // Performs the highest ranked move among the legal moves.
+        dir_t i = 0;
+
+        while (!(game->legal & (1 << order[i])))
+            ++i;
+
+        move_board(game, order[i]);
+        place_random(game);
+
+        ++move_cnt;
+    }
+
+    ++stats->tiles[game->max_val];
+    stats->moves += move_cnt;
+
+    return game->score;
+}
+
+/**
+ * @brief Compares two scores for sorting them in ascending order.
+ */
+static int compare_scores(const void *a, const void *b)
+{
+    score_t x = *(const score_t *)a, y = *(const score_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Displays the throughput and the score and maximum tile
+ * distributions of the simulated games.
+ *
+ * @param opts Pointer to the Options struct comprising the options.
+ * @param stats Pointer to the SimStats struct comprising the statistics.
+ * @param elapsed Time taken by the simulation in seconds.
+ */
+static void show_stats(Options *opts, SimStats *stats, double elapsed)
+{
+    uint32_t games = opts->simulate;
+    uint64_t total = 0;
+
+    qsort(stats->scores, games, sizeof(score_t), compare_scores);
+
+    for (uint32_t i = 0; i < games; ++i)
+        total += stats->scores[i];
+
+    printf("Simulated %u games on a %ux%u board with the %s policy in %.3f s (seed %llu)\n",
+           games, opts->size, opts->size, opts->policy, elapsed, (unsigned long long)opts->seed);
+    printf("  %-10s %llu (%.0f moves/sec)\n", "Moves:", (unsigned long long)stats->moves, stats->moves / elapsed);
+    printf("  %-10s %.1f games/sec\n", "Games:", games / elapsed);
+
+    if (stats->nodes)
+        printf("  %-10s %llu (%.0f nodes/sec, %u threads)\n", "Nodes:",
+               (unsigned long long)stats->nodes, stats->nodes / elapsed, opts->threads);
+
+    if (stats->nodes && opts->budget)
+        printf("  %-10s %.2f mean, %u max (%u ms per move)\n", "Depth:",
+               (double)stats->depths / stats->moves, stats->max_depth, opts->budget);
+
+    else if (stats->nodes)
+        printf("  %-10s %u\n", "Depth:", opts->depth);
+
+    if (stats->hits + stats->misses)
+        printf("  %-10s %llu hits, %llu misses (%.1f%% hit rate, %u MiB)\n", "Table:",
+               (unsigned long long)stats->hits, (unsigned long long)stats->misses,
+               100.0 * stats->hits / (stats->hits + stats->misses), opts->table);
+
+    printf("\n");
+
+    printf("Score distribution:\n");
+    printf("  %-10s %llu\n", "Min:", (unsigned long long)stats->scores[0]);
+    printf("  %-10s %.1f\n", "Mean:", (double)total / games);
+
+    // Percentiles are selected with the nearest-rank method.
+    static const uint8_t percentiles[] = {25, 50, 75, 90, 99};
+
+    for (len_t i = 0; i < sizeof(percentiles); ++i)
+    {
+        uint32_t rank = ((uint64_t)percentiles[i] * games + 99) / 100;
+        char label[8];
+
+        snprintf(label, sizeof(label), "p%u:", percentiles[i]);
+        printf("  %-10s %llu\n", label, (unsigned long long)stats->scores[rank ? rank - 1 : 0]);
+    }
+
+    printf("  %-10s %llu\n\n", "Max:", (unsigned long long)stats->scores[games - 1]);
+
+    printf("Max tile distribution:\n");
+
+    for (len_t i = 0; i <= MAX_TILE; ++i)
+    {
+        if (!stats->tiles[i])
+            continue;
+
+        // Tile values beyond the range of 64 bits are displayed as powers of 2.
+        char tile[24];
+
+        if (i < 64)
+            snprintf(tile, sizeof(tile), "%llu", 1ULL << i);
+
+        else
+            snprintf(tile, sizeof(tile), "2^%u", i);
+
+        printf("  %-10s %-10u %6.2f%%\n", tile, stats->tiles[i], 100.0 * stats->tiles[i] / games);
+    }
+}
+
+/**
+ * @brief Runs the headless batch simulation.
+ *
+ * @details Plays the number of games specified in the options with the
+ * specified move policy without initializing the TUI environment, and
+ * displays the statistics of the simulation on the standard output.
+ *
+ * @param opts Pointer to the Options struct comprising the options.
+ * @return Boolean value indicating whether the simulation was successful.
+ */
+bool run_simulation(Options *opts)
+{
+    const Policy *policy = NULL;
+
+    for (len_t i = 0; i < policy_cnt; ++i)
+        if (!strcmp(policies[i].name, opts->policy))
+            policy = &policies[i];
+
+    if (!policy)
+    {
+        fprintf(stderr, "Unknown policy '%s'; expected random, greedy, cyclic or expectimax.\n",
+                opts->policy);
+        return false;
+    }
+
+    if (policy->packed && opts->size != BOARD_SIZE)
+    {
+        fprintf(stderr, "The %s policy only supports the %ux%u board.\n",
+                policy->name, BOARD_SIZE, BOARD_SIZE);
+        return false;
+    }
+
+    if (opts->weights && !policy->packed)
+    {
+        fprintf(stderr, "The weights are only used by the expectimax policy.\n");
+        return false;
+    }
+
+    SimStats stats = {
+        .scores = (score_t *)malloc(opts->simulate * sizeof(score_t)),
+    };
+
+    if (!stats.scores)
+    {
+        fprintf(stderr, "Unable to allocate memory for %u games.\n", opts->simulate);
+        return false;
+    }
+
+    // The seed is stored back in the options to be reported along with
+    // the statistics, such that the simulation can be reproduced.
+    if (!opts->seeded)
+        opts->seed = time(NULL);
+
+    Game game = {.size = opts->size};
+
+    seed_rng(&game.rng, opts->seed);
+    init_move_tables();
+    init_ai();
+
+    Network net;
+
+    // The network is retained for all the games and evaluates the leaves
+    // of the search in place of the heuristic.
+    if (opts->weights)
+    {
+        if (!load_network(&net, opts, false))
+        {
+            fprintf(stderr, "Unable to load the weights from '%s'.\n", opts->weights);
+            free(stats.scores);
+            return false;
+        }
+
+        set_network(&net);
+    }
+
+    TransTable table;
+    search_depth = opts->depth;
+    search_budget = (uint64_t)opts->budget * 1000000;
+
+    // The transposition table is only allocated for the search policies,
+    // and is retained across the games as the values remain valid.
+    if (policy->packed && opts->table)
+    {
+        if (!init_table(&table, (size_t)opts->table << 20))
+        {
+            fprintf(stderr, "Unable to allocate memory for the transposition table.\n");
+
+            if (opts->weights)
+                free_network(&net);
+
+            free(stats.scores);
+            return false;
+        }
+
+        search_table = &table;
+    }
+
+    if (policy->packed && !init_search_pool(opts->threads))
+    {
+        fprintf(stderr, "Unable to start %u search threads.\n", opts->threads);
+
+        if (search_table)
+            free_table(&table);
+
+        if (opts->weights)
+            free_network(&net);
+
+        free(stats.scores);
+        return false;
+    }
+
+    uint64_t start = clock_ns();
+
+    for (uint32_t i = 0; i < opts->simulate; ++i)
+        stats.scores[i] = play_game(&game, policy, &stats);
+
+    double elapsed = (clock_ns() - start) / 1e9;
+    stats.nodes = search_nodes;
+    stats.depths = search_depths, stats.max_depth = search_max_depth;
+
+    if (search_table)
+    {
+        stats.hits = table.hits, stats.misses = table.misses;
+        free_table(&table);
+    }
+
+    if (policy->packed)
+        free_search_pool();
+
+    if (opts->weights)
+    {
+        set_network(NULL);
+        free_network(&net);
+    }
+
+    show_stats(opts, &stats, elapsed);
+
+    free(stats.scores);
+
+    return true;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file soak.c
+ * @brief Defines functions for the screen transition soak test.
+ *
+ * @details This module defines functions for cycling through the in-game
+ * screens a large number of times while periodically resizing the screen,
+ * in the same manner as a long-running interactive session, and reporting
+ * the memory usage of the process as the test progresses.
+ */
+
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+#include "soak.h"
+#include "handlers.h"
+#include "logic.h"
+#include "stats.h"
+#include "shared.h"
+#include "consts.h"
+
+#include "interface/board.h"
+#include "interface/menu.h"
+
+// Number of transitions after which the screen is resized.
+#define RESIZE_INTERVAL 4
+
+// Number of progress reports displayed over the course of the test.
+#define REPORT_CNT 10
+
+#ifndef __APPLE__
+/**
+ * @brief Reads the specified field from the status file of the process.
+ *
+ * @param key Name of the field followed by a colon, e.g. "VmRSS:".
+ * @return Value of the field in kibibytes, or -1 if it cannot be read.
+ */
+static long read_status(const char *key)
+{
+    FILE *file = fopen("/proc/self/status", "r");
+    size_t len = strlen(key);
+    char line[128];
+    long value = -1;
+
+    if (!file)
+        return -1;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        if (!strncmp(line, key, len))
+        {
+            value = strtol(line + len, NULL, 10);
+            break;
+        }
+    }
+
+    fclose(file);
+    return value;
+}
+#endif
+
+/**
+ * @brief Returns the current resident set size of the process in kibibytes.
+ *
+ * @details Unlike the peak resident set size, the current size falls once
+ * memory is returned to the system, such that a temporary spike can be told
+ * apart from steady growth across the transitions.
+ *
+ * @return The resident set size, or -1 if it cannot be determined.
+ */
+static long current_rss(void)
+{
+#ifdef __APPLE__
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t cnt = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &cnt) != KERN_SUCCESS)
+        return -1;
+
+    return info.resident_size / 1024;
+#else
+    return read_status("VmRSS:");
+#endif
+}
+
+/**
+ * @brief Returns the peak resident set size of the process in kibibytes.
+ *
+ * @details On Linux, the peak is read from the same source as the current
+ * size, as the peak reported by getrusage is only updated periodically and
+ * can fall behind the current size.
+ */
+static long peak_rss(void)
+{
+#ifdef __APPLE__
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss / 1024;
+#else
+    return read_status("VmHWM:");
+#endif
+}
+
+/**
+ * @brief Displays the screen associated with the specified transition.
+ *
+ * @details Cycles through the main menu, the game board and the pause
+ * menu, performing a move on the game board each time it is displayed.
+ *
+ * @param transition Index of the transition.
+ * @param scr_dim Pointer to the Dimension struct comprising the
+ * screen dimensions.
+ */
+static void show_screen(uint32_t transition, Dimension *scr_dim)
+{
+    WinContext wctx;
+    Dimension dim;
+
+    wctx.dimension = &dim;
+    clear();
+
+    switch (transition % 3)
+    {
+    case 0:
+        init_main_menu(&wctx, scr_dim);
+        show_main_menu(&wctx, 0);
+        break;
+
+    case 1:
+        init_game_win(&wctx, scr_dim, game.size);
+
+        if (!game.init || is_game_over(&game))
+            setup_game(&game);
+
+        // Performs the first legal move in the order of the directions.
+        else
+        {
+            move_board(&game, __builtin_ctz(game.legal));
+            place_random(&game);
+        }
+
+        show_board(&wctx, &game, NULL, scr_dim);
+        break;
+
+    default:
+        init_pause_menu(&wctx, scr_dim);
+        show_pause_menu(&wctx, 0);
+    }
+}
+
+/**
+ * @brief Runs the screen transition soak test.
+ *
+ * @details Displays the in-game screens for the number of transitions
+ * specified in the options, alternating the screen between two sizes at
+ * regular intervals, and displays the current and the peak resident set
+ * sizes at regular intervals on the standard output. The TUI environment
+ * must be set up beforehand to display the screens on a stream other than
+ * the terminal.
+ *
+ * @param opts Pointer to the Options struct comprising the options.
+ */
+void run_soak(Options *opts)
+{
+    // Stores the alternate screen dimensions, both of
+    // which meet the minimum requirements for the screens.
+    len_t height = BOARD_HEIGHT(game.size) + BOARD_MARGIN;
+    Dimension scr_dims[] = {
+        {.height = height > MIN_HEIGHT ? height : MIN_HEIGHT, .width = MIN_WIDTH},
+        {.height = (height > MIN_HEIGHT ? height : MIN_HEIGHT) + 10, .width = MIN_WIDTH + 40},
+    };
+
+    uint32_t interval = opts->soak / REPORT_CNT ? opts->soak / REPORT_CNT : 1;
+    Dimension *scr_dim = NULL;
+
+    printf("%-14s %14s %14s\n", "transitions", "RSS (KiB)", "peak RSS (KiB)");
+    printf("%-14u %14ld %14ld\n", 0u, current_rss(), peak_rss());
+
+    uint64_t start = clock_ns();
+
+    for (uint32_t i = 0; i < opts->soak; ++i)
+    {
+        if (i % RESIZE_INTERVAL == 0)
+        {
+            scr_dim = &scr_dims[i / RESIZE_INTERVAL % 2];
+            resizeterm(scr_dim->height, scr_dim->width);
+        }
+
+        show_screen(i, scr_dim);
+
+        if ((i + 1) % interval == 0 || i + 1 == opts->soak)
+            printf("%-14u %14ld %14ld\n", i + 1, current_rss(), peak_rss());
+    }
+
+    double elapsed = (clock_ns() - start) / 1e9;
+
+    printf("\n%u transitions in %.3f s (%.0f transitions/sec)\n",
+           opts->soak, elapsed, opts->soak / elapsed);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file stats.c
+ * @brief Defines functions for recording the latency statistics.
+ *
+ * @details This module defines functions for recording the durations of
+ * the stages of the frames displayed on the game board in histograms, and
+ * for computing and dumping their percentiles.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "stats.h"
+#include "shared.h"
+#include "consts.h"
+
+/**
+ * @brief Returns the current value of the monotonic clock in nanoseconds.
+ */
+uint64_t clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief Computes the index of the histogram bucket comprising the value.
+ *
+ * @details Values smaller than the number of sub-buckets are stored in
+ * individual buckets. Larger values are stored in the bucket indexed by
+ * the position of their most significant bit along with the bits which
+ * immediately follow it, such that the relative error stays constant.
+ */
+static uint16_t bucket_index(uint64_t ns)
+{
+    if (ns < (1 << HIST_SUB_BITS))
+        return ns;
+
+    uint8_t msb = 63 - __builtin_clzll(ns);
+    uint8_t shift = msb - HIST_SUB_BITS;
+
+    return ((shift + 1) << HIST_SUB_BITS) | ((ns >> shift) & ((1 << HIST_SUB_BITS) - 1));
+}
+
+/**
+ * @brief Computes the largest value stored within the specified bucket.
+ */
+static uint64_t bucket_limit(uint16_t index)
+{
+    if (index < (1 << HIST_SUB_BITS))
+        return index;
+
+    uint8_t shift = (index >> HIST_SUB_BITS) - 1;
+    uint64_t base = (1 << HIST_SUB_BITS) | (index & ((1 << HIST_SUB_BITS) - 1));
+
+    return ((base + 1) << shift) - 1;
+}
+
+/**
+ * @brief Records the specified duration in the histogram.
+ *
+ * @param hist Pointer to the Histogram struct to store the duration.
+ * @param ns The duration in nanoseconds.
+ */
+void record_sample(Histogram *hist, uint64_t ns)
+{
+    ++hist->buckets[bucket_index(ns)];
+    ++hist->count;
+
+    if (ns > hist->max)
+        hist->max = ns;
+}
+
+/**
+ * @brief Computes the specified percentile of the recorded durations.
+ *
+ * @details The percentile is selected with the nearest-rank method, and
+ * is reported as the upper limit of the bucket comprising it, capped at
+ * the maximum recorded duration.
+ *
+ * @param hist Pointer to the Histogram struct comprising the durations.
+ * @param percentile The percentile to be computed, from 1 to 100.
+ *
+ * @return The percentile in nanoseconds, or 0 if no durations are recorded.
+ */
+uint64_t hist_percentile(const Histogram *hist, uint8_t percentile)
+{
+    uint64_t rank = (hist->count * percentile + 99) / 100, seen = 0;
+
+    for (uint16_t i = 0; i < HIST_BUCKETS && rank; ++i)
+    {
+        if ((seen += hist->buckets[i]) < rank)
+            continue;
+
+        uint64_t limit = bucket_limit(i);
+        return limit < hist->max ? limit : hist->max;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes the percentiles of the specified histogram on a single row.
+ */
+static void dump_histogram(FILE *file, const char *name, const Histogram *hist)
+{
+    fprintf(file, "%-8s %10llu %12.1f %12.1f %12.1f\n", name,
+            (unsigned long long)hist->count, hist_percentile(hist, 50) / 1e3,
+            hist_percentile(hist, 99) / 1e3, hist->max / 1e3);
+}
+
+/**
+ * @brief Writes the latency and frame statistics to the specified file.
+ *
+ * @param path Path of the file to be written.
+ * @param stats Pointer to the LatencyStats struct comprising the latencies.
+ * @param frames Pointer to the FrameStats struct comprising the number of
+ * moves performed for each frame.
+ *
+ * @return Boolean value indicating whether the file was written.
+ */
+bool dump_stats(const char *path, const LatencyStats *stats, const FrameStats *frames)
+{
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+        return false;
+
+    fprintf(file, "%-8s %10s %12s %12s %12s\n", "stage", "samples", "p50 (us)", "p99 (us)", "max (us)");
+
+    dump_histogram(file, "logic", &stats->logic);
+    dump_histogram(file, "render", &stats->render);
+    dump_histogram(file, "flush", &stats->flush);
+    dump_histogram(file, "total", &stats->total);
+
+    fprintf(file, "\nframes %llu, moves %llu, max moves per frame %u\n",
+            (unsigned long long)frames->frames, (unsigned long long)frames->moves, frames->max_batch);
+
+    fprintf(file, "\n%-8s %10s\n", "moves", "frames");
+
+    for (len_t i = 0; i <= MAX_BATCH; ++i)
+    {
+        if (!frames->batches[i])
+            continue;
+
+        // The last bucket comprises all the larger batches as well.
+        char label[8];
+        snprintf(label, sizeof(label), "%u%s", i, i == MAX_BATCH ? "+" : "");
+
+        fprintf(file, "%-8s %10u\n", label, frames->batches[i]);
+    }
+
+    return !fclose(file);
+}
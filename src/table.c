@@ -0,0 +1,190 @@
+/**
+ * @file table.c
+ * @brief Defines the transposition table for the expectimax search.
+ *
+ * @details This module defines a fixed-size hash table for storing the
+ * values of the game boards already searched, such that the game boards
+ * reached through different sequences of moves are only searched once.
+ *
+ * The game boards are stored in their canonical form, such that a single
+ * entry serves all the rotations and reflections of a game board. Entries
+ * are grouped into buckets of a single cache line each, such that a lookup
+ * only touches a single cache line, and the entry with the lowest depth
+ * within the bucket is replaced once the bucket is full.
+ *
+ * The table is shared by all the threads of the search without any locks.
+ * The words of the entries are read and written with relaxed atomic
+ * operations, and the entries torn by the concurrent writes are detected
+ * through the key being stored XORed with the data.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "table.h"
+#include "shared.h"
+#include "consts.h"
+
+/**
+ * @brief Computes the bucket of the transposition table for the key.
+ *
+ * @details Multiplies the key with the 64-bit golden ratio constant and
+ * folds the upper half into the lower half, such that all the cells of
+ * the game board contribute to the bits used for indexing.
+ */
+static inline TableBucket *find_bucket(TransTable *table, board_t key)
+{
+    uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    return &table->buckets[(hash ^ (hash >> 32)) & table->mask];
+}
+
+/**
+ * @brief Allocates the transposition table within the memory budget.
+ *
+ * @details The number of buckets is rounded down to a power of 2, such
+ * that the buckets can be indexed by masking the hash of the key.
+ *
+ * @param table Pointer to the TransTable struct to be initialized.
+ * @param budget Maximum size of the table in bytes, which must
+ * accommodate at least a single bucket.
+ *
+ * @return Boolean value indicating whether the allocation was successful.
+ */
+bool init_table(TransTable *table, size_t budget)
+{
+    size_t cnt = 1;
+
+    while (cnt * 2 * sizeof(TableBucket) <= budget)
+        cnt *= 2;
+
+    *table = (TransTable){
+        .buckets = (TableBucket *)aligned_alloc(CACHE_LINE, cnt * sizeof(TableBucket)),
+        .mask = cnt - 1,
+    };
+
+    if (!table->buckets)
+        return false;
+
+    memset(table->buckets, 0, cnt * sizeof(TableBucket));
+    return true;
+}
+
+/**
+ * @brief Frees the memory allocated for the transposition table.
+ * @param table Pointer to the TransTable struct.
+ */
+void free_table(TransTable *table)
+{
+    free(table->buckets);
+    table->buckets = NULL;
+}
+
+/**
+ * @brief Packs the value and the depth into the data of an entry.
+ */
+static inline uint64_t pack_entry(float value, uint8_t depth)
+{
+    union
+    {
+        float value;
+        uint32_t bits;
+    } cast = {value};
+
+    return (uint64_t)depth << 32 | cast.bits;
+}
+
+/**
+ * @brief Extracts the value from the data of an entry.
+ */
+static inline float unpack_value(uint64_t data)
+{
+    union
+    {
+        uint32_t bits;
+        float value;
+    } cast = {(uint32_t)data};
+
+    return cast.value;
+}
+
+/**
+ * @brief Extracts the depth from the data of an entry.
+ */
+static inline uint8_t unpack_depth(uint64_t data)
+{
+    return data >> 32;
+}
+
+/**
+ * @brief Looks up the value of the game board in the transposition table.
+ *
+ * @param table Pointer to the TransTable struct.
+ * @param key The canonical form of the game board.
+ * @param depth Remaining depth to be searched from the game board, where
+ * entries searched with a lower depth are not considered usable.
+ * @param value Pointer to store the value if a usable entry is found.
+ *
+ * @return Boolean value indicating whether a usable entry was found.
+ */
+bool probe_table(TransTable *table, board_t key, uint8_t depth, float *value)
+{
+    TableEntry *entries = find_bucket(table, key)->entries;
+
+    for (index_t i = 0; i < TABLE_WAYS; ++i)
+    {
+        uint64_t data = __atomic_load_n(&entries[i].data, __ATOMIC_RELAXED);
+        uint64_t check = __atomic_load_n(&entries[i].check, __ATOMIC_RELAXED);
+
+        if ((check ^ data) != key || unpack_depth(data) < depth)
+            continue;
+
+        *value = unpack_value(data);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Stores the value of the game board in the transposition table.
+ *
+ * @details Overwrites the entry of the same game board if present, or
+ * the entry with the lowest depth within the bucket otherwise, which is
+ * an unused entry if the bucket is not full.
+ *
+ * @param table Pointer to the TransTable struct.
+ * @param key The canonical form of the game board.
+ * @param depth Remaining depth the game board was searched with.
+ * @param value The searched value of the game board.
+ */
+void store_table(TransTable *table, board_t key, uint8_t depth, float value)
+{
+    TableEntry *entries = find_bucket(table, key)->entries, *victim = NULL;
+    uint8_t victim_depth = UINT8_MAX;
+
+    for (index_t i = 0; i < TABLE_WAYS; ++i)
+    {
+        uint64_t data = __atomic_load_n(&entries[i].data, __ATOMIC_RELAXED);
+        uint64_t check = __atomic_load_n(&entries[i].check, __ATOMIC_RELAXED);
+
+        // The entry is retained if it was searched with a higher depth.
+        if ((check ^ data) == key)
+        {
+            if (unpack_depth(data) > depth)
+                return;
+
+            victim = &entries[i];
+            break;
+        }
+
+        if (!victim || unpack_depth(data) < victim_depth)
+            victim = &entries[i], victim_depth = unpack_depth(data);
+    }
+
+    uint64_t data = pack_entry(value, depth);
+
+    __atomic_store_n(&victim->data, data, __ATOMIC_RELAXED);
+    __atomic_store_n(&victim->check, key ^ data, __ATOMIC_RELAXED);
+}
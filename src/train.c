@@ -0,0 +1,262 @@
+/**
+ * @file train.c
+ * @brief Defines the self-play training of the n-tuple network.
+ *
+ * @details This module defines the training of the n-tuple network with
+ * temporal difference learning over the game boards resulting from the
+ * moves, before the random values are placed. Each game is played through
+ * the game logic by selecting the move with the highest sum of the score
+ * gained and the value of the resultant game board, whose value is then
+ * used as the target of the preceding resultant game board, i.e. TD(0).
+ *
+ * The games are played in parallel by the workers of a thread pool, all of
+ * which update the same network without any locks, and the progress is
+ * reported after each batch of games along with the throughput per core.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "train.h"
+#include "ntuple.h"
+#include "logic.h"
+#include "pool.h"
+#include "random.h"
+#include "stats.h"
+#include "shared.h"
+#include "consts.h"
+
+// Stores the game played by an individual worker along with the statistics
+// of its games, occupying separate cache lines for the individual workers.
+typedef struct
+{
+    _Alignas(CACHE_LINE) Game game;
+    uint64_t games;
+    uint64_t moves;
+    uint64_t score;
+    uint64_t wins;
+    score_t max_score;
+} Trainer;
+
+static Trainer trainers[MAX_THREADS];
+
+/**
+ * @brief Plays a single game of self-play and trains the network on it.
+ *
+ * @details Unlike the interactive game, the game continues past the target
+ * value and only ends once no legal moves are left, at which point the
+ * value of the last resultant game board is trained towards 0.
+ *
+ * @param ctx Pointer to the Network struct being trained.
+ * @param worker Index of the worker playing the game.
+ * @param index Index of the game within the batch.
+ */
+static void train_game(void *ctx, uint8_t worker, uint32_t index)
+{
+    (void)index;
+
+    Network *net = (Network *)ctx;
+    Trainer *trainer = &trainers[worker];
+    Game *game = &trainer->game;
+
+    // The learning rate is spread across the weights selected by a game
+    // board, and 0 signifies the absence of a preceding game board as it
+    // cannot result from any move.
+    const float rate = TRAIN_RATE / (NTUPLE_CNT * NTUPLE_SYMS);
+    board_t prev = 0;
+    uint64_t moves = 0;
+
+    setup_game(game);
+
+    while (!is_game_over(game))
+    {
+        Game best;
+        float best_value = 0;
+        bool found = false;
+
+        for (dir_t dir = 0; dir < DIR_CNT; ++dir)
+        {
+            if (!(game->legal & (1 << dir)))
+                continue;
+
+            // The trial moves are performed on a copy of the game,
+            // leaving the game board of the game unchanged.
+            Game copy = *game;
+            float value = move_board(&copy, dir).score + evaluate_network(net, copy.board);
+
+            if (!found || value > best_value)
+            {
+                best = copy, best_value = value;
+                found = true;
+            }
+        }
+
+        if (prev)
+            update_network(net, prev, rate * (best_value - evaluate_network(net, prev)));
+
+        *game = best, prev = game->board;
+        place_random(game);
+
+        ++moves;
+    }
+
+    if (prev)
+        update_network(net, prev, -rate * evaluate_network(net, prev));
+
+    ++trainer->games;
+    trainer->moves += moves;
+    trainer->score += game->score;
+    trainer->wins += game->max_val >= TARGET;
+
+    if (game->score > trainer->max_score)
+        trainer->max_score = game->score;
+}
+
+/**
+ * @brief Accumulates the statistics of all the workers.
+ *
+ * @param cnt Number of workers.
+ * @param total Pointer to the Trainer struct for storing the statistics.
+ */
+static void sum_trainers(uint8_t cnt, Trainer *total)
+{
+    *total = (Trainer){0};
+
+    for (uint8_t i = 0; i < cnt; ++i)
+    {
+        total->games += trainers[i].games;
+        total->moves += trainers[i].moves;
+        total->score += trainers[i].score;
+        total->wins += trainers[i].wins;
+
+        if (trainers[i].max_score > total->max_score)
+            total->max_score = trainers[i].max_score;
+    }
+}
+
+/**
+ * @brief Displays the progress of the training after a batch of games.
+ *
+ * @param cur Pointer to the Trainer struct comprising the statistics
+ * accumulated up to the end of the batch.
+ * @param prev Pointer to the Trainer struct comprising the statistics
+ * accumulated up to the start of the batch.
+ * @param elapsed Time taken by the batch in seconds.
+ * @param threads Number of threads playing the games.
+ */
+static void show_progress(Trainer *cur, Trainer *prev, double elapsed, uint8_t threads)
+{
+    uint64_t games = cur->games - prev->games;
+
+    printf("  %10llu games  %10.1f mean score  %6.2f%% %u  %8.0f games/hour/core\n",
+           (unsigned long long)cur->games, (double)(cur->score - prev->score) / games,
+           100.0 * (cur->wins - prev->wins) / games, 1u << TARGET,
+           games * 3600 / elapsed / threads);
+
+    fflush(stdout);
+}
+
+/**
+ * @brief Runs the self-play training of the n-tuple network.
+ *
+ * @details Continues the training from the weights file if it exists, and
+ * starts from a network with all the weights set to 0 otherwise. Plays the
+ * number of games specified in the options across the specified number of
+ * threads, and writes the trained network back to the weights file.
+ *
+ * @param opts Pointer to the Options struct comprising the options.
+ * @return Boolean value indicating whether the training was successful.
+ */
+bool run_training(Options *opts)
+{
+    if (!opts->weights)
+    {
+        fprintf(stderr, "The training requires a weights file specified with --weights.\n");
+        return false;
+    }
+
+    if (opts->size != BOARD_SIZE)
+    {
+        fprintf(stderr, "The training only supports the %ux%u board.\n", BOARD_SIZE, BOARD_SIZE);
+        return false;
+    }
+
+    Network net;
+    bool resumed = !access(opts->weights, F_OK);
+
+    if (resumed ? !load_network(&net, opts, true) : !init_network(&net))
+    {
+        fprintf(stderr, resumed ? "Unable to load the weights from '%s'.\n"
+                                : "Unable to allocate memory for the weights of '%s'.\n",
+                opts->weights);
+        return false;
+    }
+
+    Pool pool;
+
+    if (!init_pool(&pool, opts->threads))
+    {
+        fprintf(stderr, "Unable to start %u training threads.\n", opts->threads);
+        free_network(&net);
+        return false;
+    }
+
+    // The seed is stored back in the options to be reported along with
+    // the statistics, and each worker plays with its own sequence.
+    if (!opts->seeded)
+        opts->seed = time(NULL);
+
+    init_move_tables();
+
+    for (uint8_t i = 0; i < opts->threads; ++i)
+    {
+        trainers[i] = (Trainer){.game = {.size = BOARD_SIZE}};
+        seed_rng(&trainers[i].game.rng, opts->seed + i);
+    }
+
+    printf("Training on %u games with %u threads (seed %llu)%s\n", opts->train, opts->threads,
+           (unsigned long long)opts->seed, resumed ? ", resuming from the weights file" : "");
+
+    Trainer prev = {0}, cur;
+    uint64_t start = clock_ns(), batch_start = start;
+
+    for (uint32_t done = 0; done < opts->train;)
+    {
+        uint32_t len = opts->train - done < TRAIN_BATCH ? opts->train - done : TRAIN_BATCH;
+
+        run_pool(&pool, train_game, &net, len);
+        done += len;
+
+        uint64_t now = clock_ns();
+        sum_trainers(opts->threads, &cur);
+
+        show_progress(&cur, &prev, (now - batch_start) / 1e9, opts->threads);
+        prev = cur, batch_start = now;
+    }
+
+    double elapsed = (clock_ns() - start) / 1e9;
+    free_pool(&pool);
+
+    printf("\nTrained on %u games in %.3f s\n", opts->train, elapsed);
+    printf("  %-10s %.1f games/sec (%.0f games/hour/core)\n", "Games:",
+           opts->train / elapsed, opts->train * 3600 / elapsed / opts->threads);
+    printf("  %-10s %llu (%.0f moves/sec)\n", "Moves:", (unsigned long long)cur.moves,
+           cur.moves / elapsed);
+    printf("  %-10s %.1f mean, %llu max\n", "Score:", (double)cur.score / cur.games,
+           (unsigned long long)cur.max_score);
+
+    bool saved = save_network(&net, opts->weights);
+    free_network(&net);
+
+    if (!saved)
+    {
+        fprintf(stderr, "Unable to write the weights to '%s'.\n", opts->weights);
+        return false;
+    }
+
+    printf("\nWrote the weights to '%s'.\n", opts->weights);
+    return true;
+}